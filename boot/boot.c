@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 #include <boot/cpu.h>
+#include <boot/memory.h>
 #include <boot/memory_map.h>
 #include <boot/multiboot.h>
 #include <boot/drivers/graphics/vga_color_text_mode.h>
@@ -35,8 +35,10 @@
 .long FLAGS
 .long CHECKSUM
 
-/* Create a temporary stack, starting at the bottom. */
-.section boot_stack
+/* Create a temporary stack, starting at the bottom. The section is
+ * allocated but not stored in the file, so that the linker places it in .bss
+ * with the rest of the kernel image. */
+.section .boot_stack, "aw", @nobits
 .align 16
 stack_bottom:
     .skip (1024 * 16)    # 16 KiB
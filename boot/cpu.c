@@ -91,3 +91,246 @@ void cpu_disable_interrupts(void)
         : "cc"
     );
 }
+
+uint64_t cpu_read_timestamp_counter(void)
+{
+    uint64_t timestamp;
+    asm volatile
+    (
+        "rdtsc\n"
+        : "=A" (timestamp)
+        : /* No inputs. */
+        : /* No clobbers. */
+    );
+    return (timestamp);
+}
+
+bool cpu_has_cpuid(void)
+{
+    uint32_t before;
+    uint32_t after;
+
+    /* CPUID is supported if the ID flag (bit 21) can be toggled. */
+    asm volatile
+    (
+        "pushfl\n"
+        "popl %[before]\n"
+        "movl %[before], %[after]\n"
+        "xorl $0x200000, %[after]\n"
+        "pushl %[after]\n"
+        "popfl\n"
+        "pushfl\n"
+        "popl %[after]\n"
+        "pushl %[before]\n"
+        "popfl\n"
+        : [before] "=&r" (before), [after] "=&r" (after)
+        : /* No inputs. */
+        : "cc"
+    );
+
+    return (((before ^ after) & 0x200000) != 0);
+}
+
+void cpu_cpuid(
+    uint32_t leaf,
+    uint32_t* eax,
+    uint32_t* ebx,
+    uint32_t* ecx,
+    uint32_t* edx)
+{
+    asm volatile
+    (
+        "cpuid\n"
+        : "=a" (*eax), "=b" (*ebx), "=c" (*ecx), "=d" (*edx)
+        : "a" (leaf), "c" (0)
+        : /* No clobbers. */
+    );
+}
+
+uint32_t cpu_read_cr0(void)
+{
+    uint32_t value;
+    asm volatile
+    (
+        "movl %%cr0, %[value]\n"
+        : [value] "=r" (value)
+        : /* No inputs. */
+        : /* No clobbers. */
+    );
+    return (value);
+}
+
+void cpu_write_cr0(uint32_t value)
+{
+    asm volatile
+    (
+        "movl %[value], %%cr0\n"
+        : /* No outputs. */
+        : [value] "r" (value)
+        : "memory"
+    );
+}
+
+uint32_t cpu_read_cr2(void)
+{
+    uint32_t value;
+    asm volatile
+    (
+        "movl %%cr2, %[value]\n"
+        : [value] "=r" (value)
+        : /* No inputs. */
+        : /* No clobbers. */
+    );
+    return (value);
+}
+
+uint32_t cpu_read_cr3(void)
+{
+    uint32_t value;
+    asm volatile
+    (
+        "movl %%cr3, %[value]\n"
+        : [value] "=r" (value)
+        : /* No inputs. */
+        : /* No clobbers. */
+    );
+    return (value);
+}
+
+void cpu_write_cr3(uint32_t value)
+{
+    asm volatile
+    (
+        "movl %[value], %%cr3\n"
+        : /* No outputs. */
+        : [value] "r" (value)
+        : "memory"
+    );
+}
+
+uint32_t cpu_read_cr4(void)
+{
+    uint32_t value;
+    asm volatile
+    (
+        "movl %%cr4, %[value]\n"
+        : [value] "=r" (value)
+        : /* No inputs. */
+        : /* No clobbers. */
+    );
+    return (value);
+}
+
+void cpu_write_cr4(uint32_t value)
+{
+    asm volatile
+    (
+        "movl %[value], %%cr4\n"
+        : /* No outputs. */
+        : [value] "r" (value)
+        : "memory"
+    );
+}
+
+uint64_t cpu_read_xcr0(void)
+{
+    uint64_t value;
+    asm volatile
+    (
+        "xgetbv\n"
+        : "=A" (value)
+        : "c" (0)
+        : /* No clobbers. */
+    );
+    return (value);
+}
+
+void cpu_write_xcr0(uint64_t value)
+{
+    asm volatile
+    (
+        "xsetbv\n"
+        : /* No outputs. */
+        : "A" (value), "c" (0)
+        : "memory"
+    );
+}
+
+uint16_t cpu_read_fpu_control(void)
+{
+    uint16_t value;
+    asm volatile
+    (
+        "fnstcw %[value]\n"
+        : [value] "=m" (value)
+        : /* No inputs. */
+        : /* No clobbers. */
+    );
+    return (value);
+}
+
+void cpu_write_fpu_control(uint16_t value)
+{
+    asm volatile
+    (
+        "fldcw %[value]\n"
+        : /* No outputs. */
+        : [value] "m" (value)
+        : "memory"
+    );
+}
+
+bool cpu_read_random(uint32_t* value)
+{
+    uint8_t ready;
+    asm volatile
+    (
+        "rdrand %[value]\n"
+        "setc %[ready]\n"
+        : [value] "=r" (*value), [ready] "=qm" (ready)
+        : /* No inputs. */
+        : "cc"
+    );
+    return (ready != 0);
+}
+
+void cpu_invalidate_page(uintptr_t address)
+{
+    asm volatile
+    (
+        "invlpg (%[address])\n"
+        : /* No outputs. */
+        : [address] "r" (address)
+        : "memory"
+    );
+}
+
+uint32_t cpu_get_id(void)
+{
+    return (0);
+}
+
+uint32_t cpu_save_interrupts(void)
+{
+    uint32_t flags;
+
+    asm volatile
+    (
+        "pushfl\n"
+        "popl %[flags]\n"
+        "cli\n"
+        : [flags] "=r" (flags)
+        : /* No inputs. */
+        : "memory"
+    );
+
+    return (flags & (1 << 9));
+}
+
+void cpu_restore_interrupts(uint32_t state)
+{
+    if (state != 0)
+    {
+        cpu_enable_interrupts();
+    }
+}
@@ -62,4 +62,214 @@ void cpu_enable_interrupts(void);
  */
 void cpu_disable_interrupts(void);
 
+/**
+ * @brief Reads the time-stamp counter, which counts CPU cycles since reset.
+ *
+ * @return Current value of the time-stamp counter.
+ */
+uint64_t cpu_read_timestamp_counter(void);
+
+/**
+ * @brief CPUID leaf 1 EDX bit set when 4 MiB pages are supported.
+ */
+#define CPU_FEATURE_PSE (1 << 3)
+
+/**
+ * @brief CPUID leaf 1 EDX bit set when global pages are supported.
+ */
+#define CPU_FEATURE_PGE (1 << 13)
+
+/**
+ * @brief CPUID leaf 1 EDX bit set when FXSAVE and FXRSTOR are supported.
+ */
+#define CPU_FEATURE_FXSR (1 << 24)
+
+/**
+ * @brief CPUID leaf 1 EDX bit set when SSE2 (including MOVNTI) is
+ * supported.
+ */
+#define CPU_FEATURE_SSE2 (1 << 26)
+
+/**
+ * @brief CPUID leaf 1 ECX bit set when XSAVE and XSETBV are supported.
+ */
+#define CPU_FEATURE_XSAVE (1 << 26)
+
+/**
+ * @brief CPUID leaf 1 ECX bit set when AVX is supported.
+ */
+#define CPU_FEATURE_AVX (1 << 28)
+
+/**
+ * @brief CPUID leaf 1 ECX bit set when RDRAND is supported.
+ */
+#define CPU_FEATURE_RDRAND (1 << 30)
+
+/**
+ * @brief CPUID leaf 7 EBX bit set when AVX2 is supported.
+ */
+#define CPU_FEATURE_AVX2 (1 << 5)
+
+/**
+ * @brief Precision control field of the x87 FPU control word.
+ */
+#define CPU_FPU_PRECISION_MASK 0x0300
+
+/**
+ * @brief Precision control value that rounds x87 results to the 53-bit
+ * significand of a double instead of the 64-bit extended significand.
+ */
+#define CPU_FPU_PRECISION_DOUBLE 0x0200
+
+/**
+ * @brief Checks whether the CPUID instruction is supported.
+ *
+ * @return True if CPUID can be used.
+ */
+bool cpu_has_cpuid(void);
+
+/**
+ * @brief Executes the CPUID instruction with ECX cleared.
+ *
+ * @param leaf Leaf to query, passed in EAX.
+ * @param eax Location to store EAX in.
+ * @param ebx Location to store EBX in.
+ * @param ecx Location to store ECX in.
+ * @param edx Location to store EDX in.
+ */
+void cpu_cpuid(
+    uint32_t leaf,
+    uint32_t* eax,
+    uint32_t* ebx,
+    uint32_t* ecx,
+    uint32_t* edx);
+
+/**
+ * @brief Reads control register CR0.
+ *
+ * @return Value of CR0.
+ */
+uint32_t cpu_read_cr0(void);
+
+/**
+ * @brief Writes control register CR0.
+ *
+ * @param value Value to write.
+ */
+void cpu_write_cr0(uint32_t value);
+
+/**
+ * @brief Reads control register CR2, which holds the address that caused
+ * the last page fault.
+ *
+ * @return Value of CR2.
+ */
+uint32_t cpu_read_cr2(void);
+
+/**
+ * @brief Reads control register CR3, which holds the physical address of
+ * the page directory.
+ *
+ * @return Value of CR3.
+ */
+uint32_t cpu_read_cr3(void);
+
+/**
+ * @brief Writes control register CR3, which also flushes every non-global
+ * TLB entry.
+ *
+ * @param value Value to write.
+ */
+void cpu_write_cr3(uint32_t value);
+
+/**
+ * @brief Reads control register CR4.
+ *
+ * @return Value of CR4.
+ */
+uint32_t cpu_read_cr4(void);
+
+/**
+ * @brief Writes control register CR4.
+ *
+ * @param value Value to write.
+ */
+void cpu_write_cr4(uint32_t value);
+
+/**
+ * @brief Reads extended control register XCR0, which selects the register
+ * state enabled for XSAVE. CR4.OSXSAVE must be set.
+ *
+ * @return Value of XCR0.
+ */
+uint64_t cpu_read_xcr0(void);
+
+/**
+ * @brief Writes extended control register XCR0. CR4.OSXSAVE must be set.
+ *
+ * @param value Value to write.
+ */
+void cpu_write_xcr0(uint64_t value);
+
+/**
+ * @brief Reads the x87 FPU control word.
+ *
+ * @return Value of the control word.
+ */
+uint16_t cpu_read_fpu_control(void);
+
+/**
+ * @brief Writes the x87 FPU control word.
+ *
+ * @param value Value to write.
+ */
+void cpu_write_fpu_control(uint16_t value);
+
+/**
+ * @brief Reads a random number from the CPU's hardware generator with
+ * RDRAND, which CPUID must report.
+ *
+ * @param value Where to store the random number.
+ *
+ * @return True if a number was available; the generator can run dry under
+ * heavy use.
+ */
+bool cpu_read_random(uint32_t* value);
+
+/**
+ * @brief Removes the TLB entry for a page.
+ *
+ * @param address Virtual address within the page.
+ */
+void cpu_invalidate_page(uintptr_t address);
+
+/**
+ * @brief Largest number of CPUs per-CPU data is kept for.
+ */
+#define CPU_MAX_COUNT 8
+
+/**
+ * @brief Gets the index of the CPU executing the caller, for indexing
+ * per-CPU data. Only the boot CPU is started, so this is always 0 for now.
+ *
+ * @return CPU index, less than CPU_MAX_COUNT.
+ */
+uint32_t cpu_get_id(void);
+
+/**
+ * @brief Disables hardware interrupts, returning whether they were enabled
+ * so that cpu_restore_interrupts can undo it. Calls may nest.
+ *
+ * @return State to pass to cpu_restore_interrupts.
+ */
+uint32_t cpu_save_interrupts(void);
+
+/**
+ * @brief Re-enables hardware interrupts if they were enabled when the
+ * matching cpu_save_interrupts was called.
+ *
+ * @param state State returned by cpu_save_interrupts.
+ */
+void cpu_restore_interrupts(uint32_t state);
+
 #endif /* CPU_H_INCLUDED */
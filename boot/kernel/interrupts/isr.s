@@ -53,6 +53,7 @@
 .global isr_31
 
 .extern kernel_panic
+.extern page_fault_handle
 
 .data
 
@@ -71,7 +72,6 @@ Lisr_10_msg: .string "\nFATAL EXCEPTION: INVALID TSS.\n"
 Lisr_11_msg: .string "\nFATAL EXCEPTION: SEGMENT NOT PRESENT.\n"
 Lisr_12_msg: .string "\nFATAL EXCEPTION: STACK-SEGMENT FAULT.\n"
 Lisr_13_msg: .string "\nFATAL EXCEPTION: GENERAL PROTECTION FAULT.\n"
-Lisr_14_msg: .string "\nFATAL EXCEPTION: PAGE FAULT.\n"
 Lisr_15_msg: .string "\nFATAL EXCEPTION: RESERVED INTERRUPT 15.\n"
 Lisr_16_msg: .string "\nFATAL EXCEPTION: X87 FLOATING-POINT EXCEPTION.\n"
 Lisr_17_msg: .string "\nFATAL EXCEPTION: ALIGNMENT CHECK.\n"
@@ -208,13 +208,23 @@ isr_13:
     pushl $Lisr_13_msg
     call kernel_panic
 
-/* Handles Page Fault exception. */
+/* Handles Page Fault exception. The fault may be resolved, so unlike the
+ * other exceptions this one returns to the faulting instruction. */
 .align 8
 isr_14:
     pushal
+    cld
 
-    pushl $Lisr_14_msg
-    call kernel_panic
+    /* Passes the error code pushed by the CPU, above the saved registers. */
+    pushl 32(%esp)
+    call page_fault_handle
+    addl $4, %esp
+
+    popal
+
+    /* Discards the error code before returning. */
+    addl $4, %esp
+    iret
 
 /* Handles Reserved Interrupt 15 exception. */
 .align 8
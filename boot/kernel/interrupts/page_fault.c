@@ -0,0 +1,72 @@
+/*
+ * page_fault.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <stdio.h>
+
+#include <globals.h>
+#include <boot/cpu.h>
+#include <boot/kernel/kernel.h>
+#include <boot/kernel/interrupts/page_fault.h>
+#include <boot/kernel/memory/demand_zero.h>
+#include <boot/kernel/memory/vmalloc.h>
+
+void page_fault_handle(uint32_t error)
+{
+    uintptr_t address = cpu_read_cr2();
+
+    if (LIKELY(demand_zero_handle_fault(address, error)
+        || vmalloc_handle_fault(address, error)))
+    {
+        return;
+    }
+
+    const char* access = "READ";
+
+    if ((error & PAGE_FAULT_INSTRUCTION) != 0)
+    {
+        access = "FETCH";
+    }
+    else if ((error & PAGE_FAULT_WRITE) != 0)
+    {
+        access = "WRITE";
+    }
+
+    /* Large enough for the longest message, plus the terminator written by
+     * kernel_panic. */
+    static char message[128];
+
+    int length = snprintf
+    (
+        message, sizeof(message),
+        "\nFATAL EXCEPTION: PAGE FAULT AT 0x%X (%s, %s%s%s).\n",
+        (unsigned int) address,
+        ((error & PAGE_FAULT_PRESENT) != 0) ? "PROTECTION" : "NOT PRESENT",
+        access,
+        ((error & PAGE_FAULT_USER) != 0) ? ", USER" : "",
+        ((error & PAGE_FAULT_RESERVED) != 0) ? ", RESERVED BIT" : ""
+    );
+
+    kernel_panic(message, (size_t) length);
+}
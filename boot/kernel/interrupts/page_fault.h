@@ -0,0 +1,55 @@
+/*
+ * page_fault.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef PAGE_FAULT_H_INCLUDED
+#define PAGE_FAULT_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Page fault error code bits. */
+
+/* Set if the page was present, so the fault is a protection violation. */
+#define PAGE_FAULT_PRESENT 0x01
+
+/* Set if the faulting access was a write. */
+#define PAGE_FAULT_WRITE 0x02
+
+/* Set if the faulting access came from user mode. */
+#define PAGE_FAULT_USER 0x04
+
+/* Set if a reserved bit was set in a paging structure. */
+#define PAGE_FAULT_RESERVED 0x08
+
+/* Set if the fault was caused by an instruction fetch. */
+#define PAGE_FAULT_INSTRUCTION 0x10
+
+/**
+ * @brief Handles a page fault. Faults on demand-zero regions are resolved
+ * and execution resumes; any other fault panics with the faulting address
+ * and a decoded error code. Called by isr_14.
+ *
+ * @param error Error code pushed by the CPU.
+ */
+void page_fault_handle(uint32_t error);
+
+#endif /* PAGE_FAULT_H_INCLUDED */
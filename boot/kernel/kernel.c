@@ -34,12 +34,17 @@
 #include <boot/port_io.h>
 #include <boot/kernel/kernel.h>
 #include <boot/kernel/kernel_initialize.h>
+#include <boot/kernel/memory/zero_pool.h>
 #include <boot/ui/terminal.h>
 
 #ifdef TEST
 #include <boot/kernel/kernel_test.h>
 #endif /* TEST */
 
+#ifdef BENCHMARK
+#include <boot/kernel/kernel_benchmark.h>
+#endif /* BENCHMARK */
+
 void kernel_main(void)
 {
     terminal_write_string("Kernel booted.\n");
@@ -55,10 +60,16 @@ void kernel_main(void)
     kernel_test_start();
     #endif /* TEST */
 
+    #ifdef BENCHMARK
+    kernel_benchmark_start();
+    #endif /* BENCHMARK */
+
     char tstr[] = "this is a string\n";
     write(tstr, strlen(tstr));
 
     terminal_write_string("Kernel stopped successfully.\n");
+
+    kernel_idle();
 }
 
 void kernel_panic(char* str, size_t len)
@@ -66,8 +77,9 @@ void kernel_panic(char* str, size_t len)
     /* Ensures that the panic message is null-terminated. */
     str[len] = '\0';
 
-    /* Prints error message. */
-    write(str, len);
+    /* Prints error message, even if the panic struck while stdout was
+     * locked. */
+    write_emergency(str, len);
 
     /* Prevents further execution. */
     asm volatile
@@ -81,3 +93,16 @@ void kernel_panic(char* str, size_t len)
         : "cc"
     );
 }
+
+void kernel_idle(void)
+{
+    for (;;)
+    {
+        /* Halts only once there is nothing left to do, to be woken by the
+         * next interrupt. */
+        if (!zero_pool_refill())
+        {
+            cpu_halt();
+        }
+    }
+}
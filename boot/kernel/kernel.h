@@ -41,4 +41,10 @@ void kernel_main(void);
  */
 void kernel_panic(char* str, size_t len);
 
+/**
+ * @brief Runs background work, such as zeroing free memory, whenever there
+ * is any, and halts the CPU otherwise. Never returns.
+ */
+void kernel_idle(void);
+
 #endif /* KERNEL_HPP_INCLUDED */
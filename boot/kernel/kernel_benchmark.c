@@ -0,0 +1,1622 @@
+/*
+ * kernel_benchmark.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <globals.h>
+#include <boot/cpu.h>
+#include <boot/port_io.h>
+#include <boot/kernel/kernel_benchmark.h>
+#include <boot/kernel/memory/arena.h>
+#include <boot/kernel/memory/demand_zero.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/memory_statistics.h>
+#include <boot/kernel/memory/paging.h>
+#include <boot/kernel/memory/slab.h>
+#include <boot/kernel/memory/vmalloc.h>
+#include <boot/kernel/memory/zero_pool.h>
+#include <boot/kernel/random/random.h>
+#include <boot/kernel/simd/simd.h>
+#include <boot/kernel/string_builder/string_builder.h>
+#include <boot/ui/terminal.h>
+
+/**
+ * @brief Input frequency of the programmable interval timer, in Hz.
+ */
+#define PIT_FREQUENCY 1193182
+
+/**
+ * @brief PIT mode/command port.
+ */
+#define PIT_COMMAND_PORT 0x43
+
+/**
+ * @brief PIT channel 2 data port.
+ */
+#define PIT_CHANNEL_2_PORT 0x42
+
+/**
+ * @brief Port controlling the PIT channel 2 gate and reporting its output.
+ */
+#define PIT_CHANNEL_2_GATE_PORT 0x61
+
+/**
+ * @brief Number of timer periods per second used for calibration (50 ms).
+ */
+#define CALIBRATION_DIVISOR 20
+
+/**
+ * @brief Number of blocks held at once by the frame allocator benchmark.
+ */
+#define FRAME_BENCHMARK_BLOCKS 1024
+
+/**
+ * @brief Number of allocate/free rounds run by the frame allocator
+ * benchmark.
+ */
+#define FRAME_BENCHMARK_ROUNDS 64
+
+/**
+ * @brief Number of live allocations kept by the heap benchmark.
+ */
+#define HEAP_BENCHMARK_SLOTS 256
+
+/**
+ * @brief Number of free/malloc pairs run by the heap benchmark.
+ */
+#define HEAP_BENCHMARK_OPERATIONS 100000
+
+/**
+ * @brief Number of malloc/free pairs run by the magazine benchmark.
+ */
+#define MAGAZINE_BENCHMARK_OPERATIONS 100000
+
+/**
+ * @brief Number of objects allocated at once by the magazine benchmark, far
+ * more than a CPU's magazines hold, so that the depot is exercised.
+ */
+#define MAGAZINE_BENCHMARK_BURST 2048
+
+/**
+ * @brief Number of short-lived objects allocated per round by the arena
+ * benchmark.
+ */
+#define ARENA_BENCHMARK_OBJECTS 256
+
+/**
+ * @brief Number of allocate-then-release rounds run by the arena benchmark.
+ */
+#define ARENA_BENCHMARK_ROUNDS 400
+
+/**
+ * @brief Number of times the zero pool benchmark refills and empties the
+ * pool.
+ */
+#define ZERO_POOL_BENCHMARK_ROUNDS 64
+
+/**
+ * @brief Bytes appended per realloc by the buffer growth benchmark.
+ */
+#define REALLOC_BENCHMARK_STEP 16
+
+/**
+ * @brief Size the buffer growth benchmark grows its buffer to.
+ */
+#define REALLOC_BENCHMARK_SIZE (256 * 1024)
+
+/**
+ * @brief Largest amount of physical memory mapped by the TLB benchmark. It
+ * spans far more 4 KiB pages than any TLB holds.
+ */
+#define TLB_BENCHMARK_SIZE (16 * 1024 * 1024)
+
+/**
+ * @brief Number of passes the TLB benchmark makes over each mapping.
+ */
+#define TLB_BENCHMARK_PASSES 16
+
+/**
+ * @brief Virtual address the TLB benchmark maps with 4 KiB pages.
+ */
+#define TLB_BENCHMARK_SMALL_BASE 0x40000000
+
+/**
+ * @brief Virtual address the TLB benchmark maps with 4 MiB pages.
+ */
+#define TLB_BENCHMARK_LARGE_BASE 0x80000000
+
+/**
+ * @brief Size of the region reserved by the demand-zero benchmark.
+ */
+#define DEMAND_ZERO_BENCHMARK_SIZE (64 * 1024 * 1024)
+
+/**
+ * @brief Distance between the pages touched by the demand-zero benchmark,
+ * like a sparsely used table.
+ */
+#define DEMAND_ZERO_BENCHMARK_STRIDE (16 * 4096)
+
+/**
+ * @brief Size of each buffer allocated by the vmalloc benchmark.
+ */
+#define VMALLOC_BENCHMARK_SIZE (1024 * 1024)
+
+/**
+ * @brief Number of buffers the vmalloc benchmark allocates and frees.
+ */
+#define VMALLOC_BENCHMARK_BUFFERS 32
+
+/**
+ * @brief Largest size measured by the memory function benchmark. Sizes go
+ * up from 1 byte by factors of MEMORY_BENCHMARK_STEP.
+ */
+#define MEMORY_BENCHMARK_SIZE (1024 * 1024)
+
+/**
+ * @brief Factor between successive sizes measured by the memory function
+ * benchmark.
+ */
+#define MEMORY_BENCHMARK_STEP 4
+
+/**
+ * @brief Bytes processed at each size by the memory function benchmark.
+ */
+#define MEMORY_BENCHMARK_BYTES (4 * 1024 * 1024)
+
+/**
+ * @brief Distance by which the memory function benchmark's memmove shifts
+ * its buffer up, so that the copy overlaps and runs backwards.
+ */
+#define MEMORY_BENCHMARK_SHIFT 64
+
+/**
+ * @brief Largest string measured by the string function benchmark. Lengths
+ * go up from 4 by factors of MEMORY_BENCHMARK_STEP.
+ */
+#define STRING_BENCHMARK_LENGTH 4096
+
+/**
+ * @brief Bytes scanned at each length by the string function benchmark.
+ */
+#define STRING_BENCHMARK_BYTES (1024 * 1024)
+
+/**
+ * @brief Number of conversions timed for each integer formatting case.
+ */
+#define FORMAT_BENCHMARK_OPERATIONS 100000
+
+/**
+ * @brief Number of calls timed for each snprintf case.
+ */
+#define PRINTF_BENCHMARK_OPERATIONS 20000
+
+/**
+ * @brief Number of pieces in each message built by the string builder
+ * benchmark.
+ */
+#define BUILDER_BENCHMARK_PIECES 64
+
+/**
+ * @brief Number of messages built for each string builder case.
+ */
+#define BUILDER_BENCHMARK_ROUNDS 1000
+
+/**
+ * @brief Number of conversions timed for each strtod case.
+ */
+#define PARSE_BENCHMARK_OPERATIONS 20000
+
+/**
+ * @brief Number of keys sorted and searched by the sort benchmark.
+ */
+#define SORT_BENCHMARK_KEYS 16384
+
+/**
+ * @brief Number of numbers drawn from each generator by the random
+ * benchmark.
+ */
+#define RANDOM_BENCHMARK_OPERATIONS 100000
+
+/**
+ * @brief Measures how many time-stamp counter ticks elapse per second
+ * using PIT channel 2.
+ */
+static void calibrate(void);
+
+/**
+ * @brief Writes a benchmark result as cycles per operation and operations
+ * per second.
+ *
+ * @param name Name of the measured operation.
+ * @param operations Number of operations measured.
+ * @param cycles Time-stamp counter ticks spent on the operations.
+ */
+static void report(const char* name, size_t operations, uint64_t cycles);
+
+/**
+ * @brief Writes a labelled decimal number followed by a newline.
+ *
+ * @param label Label to write before the number.
+ * @param value Number to write.
+ */
+static void write_value(const char* label, size_t value);
+
+/**
+ * @brief Writes a throughput as bytes per cycle, with two decimals.
+ *
+ * @param label Label to write before the throughput.
+ * @param bytes Number of bytes processed.
+ * @param cycles Time-stamp counter ticks spent processing them.
+ */
+static void write_throughput(const char* label, size_t bytes, uint64_t cycles);
+
+/**
+ * @brief Benchmarks memcpy, memset and an overlapping memmove, reporting
+ * bytes per cycle for sizes from 1 byte to MEMORY_BENCHMARK_SIZE, with the
+ * scalar code and then with the vector code chosen at boot.
+ */
+static void benchmark_memory_functions(void);
+
+/**
+ * @brief Writes one line of throughputs per size for memcpy, memset and an
+ * overlapping memmove.
+ *
+ * @param source Buffer of MEMORY_BENCHMARK_SIZE + MEMORY_BENCHMARK_SHIFT
+ * bytes.
+ * @param destination Buffer of MEMORY_BENCHMARK_SIZE bytes.
+ */
+static void measure_memory_functions(uint8_t* source, uint8_t* destination);
+
+/**
+ * @brief Benchmarks strlen, strchr, memchr and memcmp scanning whole
+ * strings, with the scalar code and then with the vector code.
+ */
+static void benchmark_string_functions(void);
+
+/**
+ * @brief Writes one line of throughputs per length for strlen, strchr,
+ * memchr and memcmp.
+ *
+ * @param string String of STRING_BENCHMARK_LENGTH - 1 characters.
+ * @param copy Copy of the string.
+ */
+static void measure_string_functions(const char* string, const char* copy);
+
+/**
+ * @brief Benchmarks itoa and sitoa on short and long decimal values, on
+ * negative values and on hexadecimal values.
+ */
+static void benchmark_integer_formatting(void);
+
+/**
+ * @brief Benchmarks snprintf on a single number and on a log line, against
+ * building the same line with sitoa, strcpy and strcat.
+ */
+static void benchmark_snprintf(void);
+
+/**
+ * @brief Benchmarks building a message of many pieces with strcat, with
+ * stpcpy, and with a string builder on the heap and on a fixed buffer.
+ */
+static void benchmark_string_builder(void);
+
+/**
+ * @brief Benchmarks strtod on a number for each of its paths: exact
+ * arithmetic, Eisel-Lemire, and the slow path for a halfway case.
+ */
+static void benchmark_strtod(void);
+
+/**
+ * @brief Benchmarks strtol on short and long decimal numbers and on
+ * hexadecimal numbers.
+ */
+static void benchmark_strtol(void);
+
+/**
+ * @brief Benchmarks qsort against qsort_uint32, and bsearch against
+ * bsearch_uint32, on random 32-bit keys.
+ */
+static void benchmark_sort(void);
+
+/**
+ * @brief Benchmarks a seeded generator, rand, the per-CPU generator,
+ * bounded draws, and filling a buffer.
+ */
+static void benchmark_random(void);
+
+/**
+ * @brief Compares two 32-bit unsigned integers for qsort and bsearch.
+ *
+ * @param a First integer.
+ * @param b Second integer.
+ *
+ * @return Negative, zero or positive as a is less than, equal to or
+ * greater than b.
+ */
+static int compare_keys(const void* a, const void* b);
+
+/**
+ * @brief Benchmarks allocating and freeing physical frames.
+ */
+static void benchmark_frame_allocator(void);
+
+/**
+ * @brief Benchmarks steady-state malloc/free churn over mixed sizes.
+ */
+static void benchmark_heap(void);
+
+/**
+ * @brief Benchmarks malloc/free through the per-CPU magazines against the
+ * slab allocator they front, for back-to-back pairs and for bursts that
+ * overflow the magazines. Only the boot CPU runs, so this measures what the
+ * magazines cost or save on one CPU, not how they relieve contention.
+ */
+static void benchmark_magazine(void);
+
+/**
+ * @brief Benchmarks batches of short-lived allocations released together
+ * by an arena reset, against the same batches freed one by one.
+ */
+static void benchmark_arena(void);
+
+/**
+ * @brief Benchmarks taking zeroed frames from the pool against allocating
+ * and zeroing them on the spot, and measures the idle-time cost of
+ * refilling the pool.
+ */
+static void benchmark_zero_pool(void);
+
+/**
+ * @brief Benchmarks growing a buffer a few bytes at a time with realloc,
+ * the way log and line buffers grow.
+ */
+static void benchmark_realloc(void);
+
+/**
+ * @brief Benchmarks touching one word per page of the same physical memory
+ * through 4 KiB and 4 MiB mappings, which differ only in TLB reach.
+ */
+static void benchmark_tlb(void);
+
+/**
+ * @brief Reads one word from every page of a mapping, at an offset that
+ * moves from page to page so that the reads do not all fall in the same
+ * cache set.
+ *
+ * @param base Virtual address of the mapping.
+ * @param size Size of the mapping, in bytes.
+ *
+ * @return Time-stamp counter ticks spent on the reads.
+ */
+static uint64_t touch_pages(uintptr_t base, size_t size);
+
+/**
+ * @brief Benchmarks reserving a large region and backing a sparse part of
+ * it on first touch.
+ */
+static void benchmark_demand_zero(void);
+
+/**
+ * @brief Benchmarks allocating large virtually contiguous buffers, backing
+ * every page on first touch and freeing them with lazy TLB flushes.
+ */
+static void benchmark_vmalloc(void);
+
+/**
+ * @brief Time-stamp counter ticks per second.
+ */
+static uint64_t timestamp_frequency;
+
+/**
+ * @brief Blocks held by the frame allocator benchmark.
+ */
+static uintptr_t frame_benchmark_blocks[FRAME_BENCHMARK_BLOCKS];
+
+/**
+ * @brief Live allocations held by the heap benchmark.
+ */
+static void* heap_benchmark_slots[HEAP_BENCHMARK_SLOTS];
+
+/**
+ * @brief Frames held by the zero pool benchmark.
+ */
+static uintptr_t zero_pool_benchmark_frames[ZERO_POOL_CAPACITY];
+
+/**
+ * @brief Objects held by the magazine benchmark.
+ */
+static void* magazine_benchmark_objects[MAGAZINE_BENCHMARK_BURST];
+
+/**
+ * @brief Objects held by the arena benchmark's malloc rounds.
+ */
+static void* arena_benchmark_objects[ARENA_BENCHMARK_OBJECTS];
+
+/**
+ * @brief Buffers held by the vmalloc benchmark.
+ */
+static uint8_t* vmalloc_benchmark_buffers[VMALLOC_BENCHMARK_BUFFERS];
+
+/**
+ * @brief Keys sorted and searched by the sort benchmark.
+ */
+static uint32_t sort_benchmark_keys[SORT_BENCHMARK_KEYS];
+
+void kernel_benchmark_start(void)
+{
+    terminal_write_string("\nBENCHMARKING KERNEL\n");
+
+    calibrate();
+    write_value("TSC MHz: ", timestamp_frequency / 1000000);
+
+    benchmark_frame_allocator();
+    benchmark_heap();
+    benchmark_magazine();
+    benchmark_arena();
+    benchmark_realloc();
+    benchmark_tlb();
+    benchmark_zero_pool();
+    benchmark_demand_zero();
+    benchmark_vmalloc();
+    benchmark_memory_functions();
+    benchmark_string_functions();
+    benchmark_integer_formatting();
+    benchmark_snprintf();
+    benchmark_string_builder();
+    benchmark_strtod();
+    benchmark_strtol();
+    benchmark_sort();
+    benchmark_random();
+
+    /* Shows what the benchmarks left behind, which should be nothing but
+     * cached slabs and magazines. */
+    memory_statistics_dump();
+
+    terminal_write_string("\nBENCHMARK COMPLETE\n");
+}
+
+static void calibrate(void)
+{
+    uint16_t latch = PIT_FREQUENCY / CALIBRATION_DIVISOR;
+
+    /* Enables the channel 2 gate with the speaker disconnected. */
+    port_outb(
+        PIT_CHANNEL_2_GATE_PORT,
+        (port_inb(PIT_CHANNEL_2_GATE_PORT) & ~0x02) | 0x01);
+
+    /* Channel 2, low byte then high byte, mode 0 (one-shot). */
+    port_outb(PIT_COMMAND_PORT, 0xB0);
+    port_outb(PIT_CHANNEL_2_PORT, latch & 0xFF);
+    port_outb(PIT_CHANNEL_2_PORT, latch >> 8);
+
+    uint64_t start = cpu_read_timestamp_counter();
+
+    /* Bit 5 goes high once the count reaches zero. */
+    while ((port_inb(PIT_CHANNEL_2_GATE_PORT) & 0x20) == 0)
+    {
+    }
+
+    uint64_t end = cpu_read_timestamp_counter();
+
+    timestamp_frequency = (end - start) * CALIBRATION_DIVISOR;
+}
+
+static void report(const char* name, size_t operations, uint64_t cycles)
+{
+    if (operations == 0)
+    {
+        operations = 1;
+    }
+    if (cycles == 0)
+    {
+        cycles = 1;
+    }
+
+    printf("%s: %zu cycles/op, %zu ops/s\n", name,
+        (size_t) (cycles / operations),
+        (size_t) ((operations * timestamp_frequency) / cycles));
+}
+
+static void write_value(const char* label, size_t value)
+{
+    printf("%s%zu\n", label, value);
+}
+
+static void write_throughput(const char* label, size_t bytes, uint64_t cycles)
+{
+    char str[33];
+
+    if (cycles == 0)
+    {
+        cycles = 1;
+    }
+
+    uint64_t hundredths = ((uint64_t) bytes * 100) / cycles;
+
+    terminal_write_string(label);
+    terminal_write_string(sitoa((size_t) (hundredths / 100), str, 10));
+    terminal_write_string((hundredths % 100 < 10) ? ".0" : ".");
+    terminal_write_string(sitoa((size_t) (hundredths % 100), str, 10));
+}
+
+static void benchmark_integer_formatting(void)
+{
+    char buffer[36];
+    uint32_t sink = 0;
+
+    terminal_write_string("\nInteger formatting\n");
+
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < FORMAT_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += sitoa(i % 10, buffer, 10)[0];
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+    report("sitoa 1 digit", FORMAT_BENCHMARK_OPERATIONS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < FORMAT_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += sitoa(4000000000U + i, buffer, 10)[9];
+    }
+    end = cpu_read_timestamp_counter();
+    report("sitoa 10 digits", FORMAT_BENCHMARK_OPERATIONS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < FORMAT_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += itoa(-1000000 - (int) i, buffer, 10)[1];
+    }
+    end = cpu_read_timestamp_counter();
+    report("itoa negative", FORMAT_BENCHMARK_OPERATIONS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < FORMAT_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += sitoa(0xC0000000 + i, buffer, 16)[2];
+    }
+    end = cpu_read_timestamp_counter();
+    report("sitoa hex", FORMAT_BENCHMARK_OPERATIONS, end - start);
+
+    /* Keeps the conversions from being optimized away. */
+    if (sink == 0)
+    {
+        terminal_write_string("No digits written\n");
+    }
+}
+
+static void benchmark_snprintf(void)
+{
+    char line[128];
+    char number[36];
+    uint32_t sink = 0;
+
+    terminal_write_string("\nFormatted output\n");
+
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < PRINTF_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += snprintf(line, sizeof(line), "%zu", 4000000000U + i);
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+    report("snprintf 10 digits", PRINTF_BENCHMARK_OPERATIONS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < PRINTF_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += snprintf(line, sizeof(line), "%s: %zu cycles/op, %zu ops/s\n",
+            "benchmark", i, 1000000 + i);
+    }
+    end = cpu_read_timestamp_counter();
+    report("snprintf log line", PRINTF_BENCHMARK_OPERATIONS, end - start);
+
+    /* The same line the way it was built before snprintf. */
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < PRINTF_BENCHMARK_OPERATIONS; ++i)
+    {
+        strcpy(line, "benchmark");
+        strcat(line, ": ");
+        strcat(line, sitoa(i, number, 10));
+        strcat(line, " cycles/op, ");
+        strcat(line, sitoa(1000000 + i, number, 10));
+        strcat(line, " ops/s\n");
+        sink += line[0];
+    }
+    end = cpu_read_timestamp_counter();
+    report("strcat log line", PRINTF_BENCHMARK_OPERATIONS, end - start);
+
+    /* Keeps the formatting from being optimized away. */
+    if (sink == 0)
+    {
+        terminal_write_string("No characters written\n");
+    }
+}
+
+static void benchmark_string_builder(void)
+{
+    static char message[BUILDER_BENCHMARK_PIECES * 8];
+    static const char piece[] = "piece, ";
+    uint32_t sink = 0;
+
+    terminal_write_string("\nString builder\n");
+
+    /* Each strcat measures the whole message again. */
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < BUILDER_BENCHMARK_ROUNDS; ++i)
+    {
+        message[0] = '\0';
+        for (size_t j = 0; j < BUILDER_BENCHMARK_PIECES; ++j)
+        {
+            strcat(message, piece);
+        }
+        sink += message[0];
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+    report("strcat message", BUILDER_BENCHMARK_ROUNDS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < BUILDER_BENCHMARK_ROUNDS; ++i)
+    {
+        char* tail = message;
+
+        for (size_t j = 0; j < BUILDER_BENCHMARK_PIECES; ++j)
+        {
+            tail = stpcpy(tail, piece);
+        }
+        sink += message[0];
+    }
+    end = cpu_read_timestamp_counter();
+    report("stpcpy message", BUILDER_BENCHMARK_ROUNDS, end - start);
+
+    /* Includes growing from nothing and freeing, as a caller would. */
+    String_Builder builder;
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < BUILDER_BENCHMARK_ROUNDS; ++i)
+    {
+        string_builder_initialize(&builder);
+        for (size_t j = 0; j < BUILDER_BENCHMARK_PIECES; ++j)
+        {
+            string_builder_append_length(&builder, piece, sizeof(piece) - 1);
+        }
+        sink += string_builder_get_string(&builder)[0];
+        string_builder_destroy(&builder);
+    }
+    end = cpu_read_timestamp_counter();
+    report("builder message", BUILDER_BENCHMARK_ROUNDS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < BUILDER_BENCHMARK_ROUNDS; ++i)
+    {
+        string_builder_initialize_buffer(&builder, message, sizeof(message));
+        for (size_t j = 0; j < BUILDER_BENCHMARK_PIECES; ++j)
+        {
+            string_builder_append_length(&builder, piece, sizeof(piece) - 1);
+        }
+        sink += string_builder_get_string(&builder)[0];
+    }
+    end = cpu_read_timestamp_counter();
+    report("builder buffer message", BUILDER_BENCHMARK_ROUNDS, end - start);
+
+    /* Keeps the messages from being optimized away. */
+    if (sink == 0)
+    {
+        terminal_write_string("No messages built\n");
+    }
+}
+
+static void benchmark_strtod(void)
+{
+    static const struct
+    {
+        const char* name;
+        const char* string;
+    } cases[] =
+    {
+        {"strtod short", "3.14159"},
+        {"strtod 17 digits", "2.2250738585072014e-308"},
+        {
+            "strtod halfway",
+            "1.00000000000000011102230246251565404236316680908203125"
+        }
+    };
+
+    terminal_write_string("\nstrtod\n");
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        /* Summing the results keeps the conversions from being optimized
+         * away. */
+        volatile double sum = 0;
+
+        uint64_t start = cpu_read_timestamp_counter();
+        for (size_t j = 0; j < PARSE_BENCHMARK_OPERATIONS; ++j)
+        {
+            sum = sum + strtod(cases[i].string, NULL);
+        }
+        uint64_t end = cpu_read_timestamp_counter();
+
+        report(cases[i].name, PARSE_BENCHMARK_OPERATIONS, end - start);
+    }
+}
+
+static void benchmark_strtol(void)
+{
+    static const struct
+    {
+        const char* name;
+        const char* string;
+        int base;
+    } cases[] =
+    {
+        {"strtol 3 digits", "512", 10},
+        {"strtol 10 digits", "2147483647", 10},
+        {"strtol hex", "0xC0000000", 0}
+    };
+
+    terminal_write_string("\nstrtol\n");
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i)
+    {
+        /* See benchmark_strtod. */
+        volatile long sum = 0;
+
+        uint64_t start = cpu_read_timestamp_counter();
+        for (size_t j = 0; j < FORMAT_BENCHMARK_OPERATIONS; ++j)
+        {
+            sum = sum + strtol(cases[i].string, NULL, cases[i].base);
+        }
+        uint64_t end = cpu_read_timestamp_counter();
+
+        report(cases[i].name, FORMAT_BENCHMARK_OPERATIONS, end - start);
+    }
+}
+
+static void benchmark_sort(void)
+{
+    /* Seeded the same way every run, so runs are comparable. */
+    Random random;
+
+    random_seed(&random, 1);
+
+    terminal_write_string("\nSort\n");
+
+    for (size_t i = 0; i < SORT_BENCHMARK_KEYS; ++i)
+    {
+        sort_benchmark_keys[i] = random_next(&random);
+    }
+    uint64_t start = cpu_read_timestamp_counter();
+    qsort(
+        sort_benchmark_keys,
+        SORT_BENCHMARK_KEYS,
+        sizeof(uint32_t),
+        compare_keys);
+    uint64_t end = cpu_read_timestamp_counter();
+    report("qsort", SORT_BENCHMARK_KEYS, end - start);
+
+    /* Sorts the same keys again for the specialized version. */
+    random_seed(&random, 1);
+    for (size_t i = 0; i < SORT_BENCHMARK_KEYS; ++i)
+    {
+        sort_benchmark_keys[i] = random_next(&random);
+    }
+    start = cpu_read_timestamp_counter();
+    qsort_uint32(sort_benchmark_keys, SORT_BENCHMARK_KEYS);
+    end = cpu_read_timestamp_counter();
+    report("qsort_uint32", SORT_BENCHMARK_KEYS, end - start);
+
+    size_t found = 0;
+
+    random_seed(&random, 1);
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < SORT_BENCHMARK_KEYS; ++i)
+    {
+        uint32_t key = random_next(&random);
+
+        found += bsearch(
+            &key,
+            sort_benchmark_keys,
+            SORT_BENCHMARK_KEYS,
+            sizeof(uint32_t),
+            compare_keys) != NULL;
+    }
+    end = cpu_read_timestamp_counter();
+    report("bsearch", SORT_BENCHMARK_KEYS, end - start);
+
+    random_seed(&random, 1);
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < SORT_BENCHMARK_KEYS; ++i)
+    {
+        found += bsearch_uint32(
+            random_next(&random),
+            sort_benchmark_keys,
+            SORT_BENCHMARK_KEYS) != NULL;
+    }
+    end = cpu_read_timestamp_counter();
+    report("bsearch_uint32", SORT_BENCHMARK_KEYS, end - start);
+
+    if (found != 2 * SORT_BENCHMARK_KEYS)
+    {
+        terminal_write_string("Keys missing after sort\n");
+    }
+}
+
+static int compare_keys(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*) a;
+    uint32_t y = *(const uint32_t*) b;
+
+    return ((x > y) - (x < y));
+}
+
+static void benchmark_random(void)
+{
+    Random random;
+    uint32_t sink = 0;
+
+    terminal_write_string("\nRandom\n");
+
+    random_seed(&random, 1);
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < RANDOM_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += random_next(&random);
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+    report("random_next", RANDOM_BENCHMARK_OPERATIONS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < RANDOM_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += (uint32_t) rand();
+    }
+    end = cpu_read_timestamp_counter();
+    report("rand", RANDOM_BENCHMARK_OPERATIONS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < RANDOM_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += random_get();
+    }
+    end = cpu_read_timestamp_counter();
+    report("random_get", RANDOM_BENCHMARK_OPERATIONS, end - start);
+
+    start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < RANDOM_BENCHMARK_OPERATIONS; ++i)
+    {
+        sink += random_next_below(&random, 1000);
+    }
+    end = cpu_read_timestamp_counter();
+    report("random_next_below", RANDOM_BENCHMARK_OPERATIONS, end - start);
+
+    /* Reuses the string benchmark's size for the buffer. */
+    uint8_t* buffer = malloc(STRING_BENCHMARK_BYTES);
+
+    if (buffer == NULL)
+    {
+        terminal_write_string("Out of memory\n");
+        return;
+    }
+
+    start = cpu_read_timestamp_counter();
+    random_fill(&random, buffer, STRING_BENCHMARK_BYTES);
+    end = cpu_read_timestamp_counter();
+    write_throughput(
+        "random_fill (bytes/cycle): ",
+        STRING_BENCHMARK_BYTES,
+        end - start);
+    terminal_write_string("\n");
+
+    sink += buffer[STRING_BENCHMARK_BYTES - 1];
+    free(buffer);
+
+    /* Keeps the draws from being optimized away. */
+    if (sink == 0)
+    {
+        terminal_write_string("No numbers drawn\n");
+    }
+}
+
+static void benchmark_frame_allocator(void)
+{
+    static const size_t orders[] = {0, 3};
+
+    terminal_write_string("\nFrame allocator\n");
+    write_value(
+        "Managed MiB: ",
+        frame_allocator_get_frame_count() / (1024 * 1024
+            / FRAME_ALLOCATOR_FRAME_SIZE));
+    write_value(
+        "Free MiB: ",
+        frame_allocator_get_free_count() / (1024 * 1024
+            / FRAME_ALLOCATOR_FRAME_SIZE));
+
+    for (size_t i = 0; i < (sizeof(orders) / sizeof(orders[0])); ++i)
+    {
+        uint64_t allocate_cycles = 0;
+        uint64_t free_cycles = 0;
+        size_t operations = 0;
+
+        for (size_t round = 0; round < FRAME_BENCHMARK_ROUNDS; ++round)
+        {
+            size_t held = 0;
+
+            uint64_t start = cpu_read_timestamp_counter();
+            while (held < FRAME_BENCHMARK_BLOCKS)
+            {
+                uintptr_t block = frame_allocator_allocate(orders[i]);
+                if (block == 0)
+                {
+                    break;
+                }
+                frame_benchmark_blocks[held] = block;
+                ++held;
+            }
+            uint64_t middle = cpu_read_timestamp_counter();
+
+            /* Frees in allocation order so that buddies are merged back
+             * together rather than just popped and pushed. */
+            for (size_t block = 0; block < held; ++block)
+            {
+                frame_allocator_free(frame_benchmark_blocks[block], orders[i]);
+            }
+            uint64_t end = cpu_read_timestamp_counter();
+
+            allocate_cycles += middle - start;
+            free_cycles += end - middle;
+            operations += held;
+        }
+
+        write_value("Order: ", orders[i]);
+        report("Allocate", operations, allocate_cycles);
+        report("Free", operations, free_cycles);
+    }
+}
+
+static void benchmark_heap(void)
+{
+    Random random;
+
+    random_seed(&random, 1);
+
+    terminal_write_string("\nHeap\n");
+
+    /* Warms up the working set so that the measured phase is steady
+     * state. */
+    for (size_t i = 0; i < HEAP_BENCHMARK_SLOTS; ++i)
+    {
+        heap_benchmark_slots[i] = malloc(8 + (random_next(&random) % 1017));
+    }
+
+    size_t free_before = frame_allocator_get_free_count();
+
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < HEAP_BENCHMARK_OPERATIONS; ++i)
+    {
+        uint32_t value = random_next(&random);
+        size_t slot = value % HEAP_BENCHMARK_SLOTS;
+
+        free(heap_benchmark_slots[slot]);
+        heap_benchmark_slots[slot] = malloc(8 + ((value >> 8) % 1017));
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+
+    size_t free_after = frame_allocator_get_free_count();
+
+    for (size_t i = 0; i < HEAP_BENCHMARK_SLOTS; ++i)
+    {
+        free(heap_benchmark_slots[i]);
+    }
+
+    report("Free+malloc", HEAP_BENCHMARK_OPERATIONS, end - start);
+    write_value("Free frames before: ", free_before);
+    write_value("Free frames after: ", free_after);
+}
+
+static void benchmark_magazine(void)
+{
+    terminal_write_string("\nMagazines\n");
+
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < MAGAZINE_BENCHMARK_OPERATIONS; ++i)
+    {
+        free(malloc(64));
+    }
+    uint64_t middle = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < MAGAZINE_BENCHMARK_OPERATIONS; ++i)
+    {
+        slab_free(slab_allocate(64));
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+
+    report("Magazine pair", MAGAZINE_BENCHMARK_OPERATIONS, middle - start);
+    report("Slab pair", MAGAZINE_BENCHMARK_OPERATIONS, end - middle);
+
+    uint64_t magazine_cycles = 0;
+    uint64_t slab_cycles = 0;
+    size_t rounds = MAGAZINE_BENCHMARK_OPERATIONS / MAGAZINE_BENCHMARK_BURST;
+
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        start = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < MAGAZINE_BENCHMARK_BURST; ++i)
+        {
+            magazine_benchmark_objects[i] = malloc(64);
+        }
+        for (size_t i = 0; i < MAGAZINE_BENCHMARK_BURST; ++i)
+        {
+            free(magazine_benchmark_objects[i]);
+        }
+        middle = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < MAGAZINE_BENCHMARK_BURST; ++i)
+        {
+            magazine_benchmark_objects[i] = slab_allocate(64);
+        }
+        for (size_t i = 0; i < MAGAZINE_BENCHMARK_BURST; ++i)
+        {
+            slab_free(magazine_benchmark_objects[i]);
+        }
+        end = cpu_read_timestamp_counter();
+
+        magazine_cycles += middle - start;
+        slab_cycles += end - middle;
+    }
+
+    report(
+        "Magazine burst",
+        rounds * MAGAZINE_BENCHMARK_BURST,
+        magazine_cycles);
+    report("Slab burst", rounds * MAGAZINE_BENCHMARK_BURST, slab_cycles);
+}
+
+static void benchmark_arena(void)
+{
+    terminal_write_string("\nArena\n");
+
+    Arena* arena = arena_create();
+
+    if (arena == NULL)
+    {
+        terminal_write_string("Out of memory\n");
+        return;
+    }
+
+    uint64_t arena_cycles = 0;
+    uint64_t heap_cycles = 0;
+    Random random;
+
+    random_seed(&random, 1);
+
+    for (size_t round = 0; round < ARENA_BENCHMARK_ROUNDS; ++round)
+    {
+        /* Both halves see the same sizes. */
+        Random round_random = random;
+
+        uint64_t start = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < ARENA_BENCHMARK_OBJECTS; ++i)
+        {
+            char* object = arena_allocate(
+                arena,
+                16 + (random_next(&random) % 113));
+
+            object[0] = '\0';
+        }
+        arena_reset(arena);
+        uint64_t middle = cpu_read_timestamp_counter();
+
+        random = round_random;
+        for (size_t i = 0; i < ARENA_BENCHMARK_OBJECTS; ++i)
+        {
+            char* object = malloc(16 + (random_next(&random) % 113));
+
+            object[0] = '\0';
+            arena_benchmark_objects[i] = object;
+        }
+        for (size_t i = 0; i < ARENA_BENCHMARK_OBJECTS; ++i)
+        {
+            free(arena_benchmark_objects[i]);
+        }
+        uint64_t end = cpu_read_timestamp_counter();
+
+        arena_cycles += middle - start;
+        heap_cycles += end - middle;
+    }
+
+    arena_destroy(arena);
+
+    report(
+        "Arena allocate",
+        ARENA_BENCHMARK_ROUNDS * ARENA_BENCHMARK_OBJECTS,
+        arena_cycles);
+    report(
+        "Malloc+free",
+        ARENA_BENCHMARK_ROUNDS * ARENA_BENCHMARK_OBJECTS,
+        heap_cycles);
+}
+
+static void benchmark_realloc(void)
+{
+    char* buffer = NULL;
+    size_t moves = 0;
+    size_t remaps = 0;
+
+    terminal_write_string("\nRealloc\n");
+
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t size = REALLOC_BENCHMARK_STEP;
+        size <= REALLOC_BENCHMARK_SIZE;
+        size += REALLOC_BENCHMARK_STEP)
+    {
+        char* grown = realloc(buffer, size);
+
+        if (grown == NULL)
+        {
+            break;
+        }
+        if (grown != buffer)
+        {
+            ++moves;
+
+            /* Moves into or within the vmalloc window copy nothing. */
+            if (vmalloc_contains(grown))
+            {
+                ++remaps;
+            }
+        }
+
+        buffer = grown;
+        buffer[size - 1] = '\0';
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+
+    free(buffer);
+
+    report(
+        "Append realloc",
+        REALLOC_BENCHMARK_SIZE / REALLOC_BENCHMARK_STEP,
+        end - start);
+    write_value("Moves: ", moves);
+    write_value("Remapped moves: ", remaps);
+}
+
+static void benchmark_tlb(void)
+{
+    size_t size = frame_allocator_get_frame_count()
+        * FRAME_ALLOCATOR_FRAME_SIZE;
+
+    terminal_write_string("\nTLB\n");
+
+    if (size > TLB_BENCHMARK_SIZE)
+    {
+        size = TLB_BENCHMARK_SIZE;
+    }
+    size &= ~(PAGING_LARGE_PAGE_SIZE - 1);
+
+    if (!paging_has_large_pages() || size == 0)
+    {
+        terminal_write_string("Skipped: no 4 MiB pages\n");
+        return;
+    }
+
+    /* Both mappings alias the same low physical memory, so the only
+     * difference between the runs is the number of TLB entries needed. */
+    for (size_t offset = 0; offset < size; offset += PAGING_PAGE_SIZE)
+    {
+        if (!paging_map(TLB_BENCHMARK_SMALL_BASE + offset, offset, 0))
+        {
+            terminal_write_string("Skipped: out of page tables\n");
+            size = offset & ~(PAGING_LARGE_PAGE_SIZE - 1);
+            break;
+        }
+    }
+    for (size_t offset = 0; offset < size; offset += PAGING_LARGE_PAGE_SIZE)
+    {
+        paging_map_large(TLB_BENCHMARK_LARGE_BASE + offset, offset, 0);
+    }
+
+    size_t pages = size / PAGING_PAGE_SIZE;
+    uint64_t small_cycles = 0;
+    uint64_t large_cycles = 0;
+
+    /* Warms the caches so that both runs read the same cached lines. */
+    touch_pages(TLB_BENCHMARK_LARGE_BASE, size);
+
+    for (size_t pass = 0; pass < TLB_BENCHMARK_PASSES; ++pass)
+    {
+        small_cycles += touch_pages(TLB_BENCHMARK_SMALL_BASE, size);
+        large_cycles += touch_pages(TLB_BENCHMARK_LARGE_BASE, size);
+    }
+
+    write_value("Mapped MiB: ", size / (1024 * 1024));
+    report("4 KiB pages", pages * TLB_BENCHMARK_PASSES, small_cycles);
+    report("4 MiB pages", pages * TLB_BENCHMARK_PASSES, large_cycles);
+
+    for (size_t offset = 0; offset < size; offset += PAGING_PAGE_SIZE)
+    {
+        paging_unmap_deferred(TLB_BENCHMARK_SMALL_BASE + offset);
+    }
+    for (size_t offset = 0; offset < size; offset += PAGING_LARGE_PAGE_SIZE)
+    {
+        paging_unmap_deferred(TLB_BENCHMARK_LARGE_BASE + offset);
+    }
+    paging_flush();
+}
+
+static uint64_t touch_pages(uintptr_t base, size_t size)
+{
+    volatile uint32_t sum = 0;
+
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t offset = 0; offset < size; offset += PAGING_PAGE_SIZE)
+    {
+        size_t line = (offset / PAGING_PAGE_SIZE) % 64;
+
+        sum += *((volatile uint32_t*) (base + offset + (line * 64)));
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+
+    (void) sum;
+
+    return (end - start);
+}
+
+static void benchmark_zero_pool(void)
+{
+    uint64_t refill_cycles = 0;
+    uint64_t pool_cycles = 0;
+    uint64_t clear_cycles = 0;
+    size_t refills = 0;
+    size_t operations = 0;
+
+    terminal_write_string("\nZero pool\n");
+
+    for (size_t round = 0; round < ZERO_POOL_BENCHMARK_ROUNDS; ++round)
+    {
+        /* Stands in for the idle loop. */
+        uint64_t start = cpu_read_timestamp_counter();
+        while (zero_pool_refill())
+        {
+            ++refills;
+        }
+        uint64_t end = cpu_read_timestamp_counter();
+
+        refill_cycles += end - start;
+
+        size_t held = 0;
+
+        start = cpu_read_timestamp_counter();
+        while (held < ZERO_POOL_CAPACITY)
+        {
+            uintptr_t frame = zero_pool_allocate(0);
+            if (frame == 0)
+            {
+                break;
+            }
+            zero_pool_benchmark_frames[held] = frame;
+            ++held;
+        }
+        end = cpu_read_timestamp_counter();
+
+        pool_cycles += end - start;
+
+        for (size_t i = 0; i < held; ++i)
+        {
+            frame_allocator_free(zero_pool_benchmark_frames[i], 0);
+        }
+
+        start = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < held; ++i)
+        {
+            uintptr_t frame = frame_allocator_allocate(0);
+            memset(
+                PAGING_PHYSICAL_TO_VIRTUAL(frame),
+                0,
+                FRAME_ALLOCATOR_FRAME_SIZE);
+            zero_pool_benchmark_frames[i] = frame;
+        }
+        end = cpu_read_timestamp_counter();
+
+        clear_cycles += end - start;
+
+        for (size_t i = 0; i < held; ++i)
+        {
+            frame_allocator_free(zero_pool_benchmark_frames[i], 0);
+        }
+
+        operations += held;
+    }
+
+    report("Zeroed frame from pool", operations, pool_cycles);
+    report("Allocate and memset", operations, clear_cycles);
+    report("Idle refill", refills, refill_cycles);
+}
+
+static void benchmark_demand_zero(void)
+{
+    terminal_write_string("\nDemand-zero\n");
+
+    size_t free_before = frame_allocator_get_free_count();
+
+    uint64_t start = cpu_read_timestamp_counter();
+    uint8_t* region = demand_zero_reserve(
+        DEMAND_ZERO_BENCHMARK_SIZE,
+        PAGING_WRITABLE);
+    uint64_t middle = cpu_read_timestamp_counter();
+
+    if (region == NULL)
+    {
+        terminal_write_string("Skipped: no virtual space\n");
+        return;
+    }
+
+    size_t touched = 0;
+
+    for (size_t offset = 0;
+        offset < DEMAND_ZERO_BENCHMARK_SIZE;
+        offset += DEMAND_ZERO_BENCHMARK_STRIDE)
+    {
+        region[offset] = 1;
+        ++touched;
+    }
+    uint64_t faulted = cpu_read_timestamp_counter();
+
+    size_t resident = demand_zero_get_resident_count();
+
+    demand_zero_release(region);
+    uint64_t end = cpu_read_timestamp_counter();
+
+    write_value("Reserved MiB: ", DEMAND_ZERO_BENCHMARK_SIZE / (1024 * 1024));
+    report("Reserve", 1, middle - start);
+    report("First touch", touched, faulted - middle);
+    report("Release", 1, end - faulted);
+    write_value("Resident frames: ", resident);
+    /* Page tables covering the window stay allocated for later regions. */
+    write_value(
+        "Frames kept as page tables: ",
+        free_before - frame_allocator_get_free_count());
+}
+
+static void benchmark_vmalloc(void)
+{
+    terminal_write_string("\nVmalloc\n");
+    write_value(
+        "Largest contiguous run (frames): ",
+        frame_allocator_get_largest_run());
+
+    uint64_t start = cpu_read_timestamp_counter();
+    for (size_t i = 0; i < VMALLOC_BENCHMARK_BUFFERS; ++i)
+    {
+        vmalloc_benchmark_buffers[i] = vmalloc_allocate(
+            VMALLOC_BENCHMARK_SIZE);
+    }
+    uint64_t middle = cpu_read_timestamp_counter();
+
+    size_t touched = 0;
+
+    for (size_t i = 0; i < VMALLOC_BENCHMARK_BUFFERS; ++i)
+    {
+        if (vmalloc_benchmark_buffers[i] == NULL)
+        {
+            continue;
+        }
+
+        for (size_t offset = 0;
+            offset < VMALLOC_BENCHMARK_SIZE;
+            offset += PAGING_PAGE_SIZE)
+        {
+            vmalloc_benchmark_buffers[i][offset] = 1;
+            ++touched;
+        }
+    }
+    uint64_t faulted = cpu_read_timestamp_counter();
+
+    size_t resident = vmalloc_get_resident_count();
+
+    for (size_t i = 0; i < VMALLOC_BENCHMARK_BUFFERS; ++i)
+    {
+        vmalloc_free(vmalloc_benchmark_buffers[i]);
+    }
+    uint64_t end = cpu_read_timestamp_counter();
+
+    report("Allocate", VMALLOC_BENCHMARK_BUFFERS, middle - start);
+    report("First touch", touched, faulted - middle);
+    report("Free", VMALLOC_BENCHMARK_BUFFERS, end - faulted);
+    write_value("Resident frames: ", resident);
+}
+
+static void benchmark_memory_functions(void)
+{
+    static const char* const level_names[] = {"none", "SSE2", "AVX2"};
+
+    terminal_write_string("\nMemory functions (bytes/cycle)\nSIMD: ");
+    terminal_write_string(level_names[simd_get_level()]);
+    terminal_write_string("\n");
+
+    uint8_t* source = malloc(MEMORY_BENCHMARK_SIZE + MEMORY_BENCHMARK_SHIFT);
+    uint8_t* destination = malloc(MEMORY_BENCHMARK_SIZE);
+
+    if (source == NULL || destination == NULL)
+    {
+        free(source);
+        free(destination);
+        terminal_write_string("Out of memory\n");
+        return;
+    }
+
+    /* Backs every page before timing anything. */
+    memset(source, 1, MEMORY_BENCHMARK_SIZE + MEMORY_BENCHMARK_SHIFT);
+    memset(destination, 2, MEMORY_BENCHMARK_SIZE);
+
+    /* Holding the vector registers makes the functions fall back to their
+     * scalar code. */
+    const Simd_Functions* held = simd_begin();
+
+    terminal_write_string("Scalar\n");
+    measure_memory_functions(source, destination);
+
+    if (held != NULL)
+    {
+        simd_end();
+
+        terminal_write_string("Vector\n");
+        measure_memory_functions(source, destination);
+    }
+
+    free(source);
+    free(destination);
+}
+
+static void measure_memory_functions(uint8_t* source, uint8_t* destination)
+{
+    char str[33];
+
+    for (size_t size = 1;
+        size <= MEMORY_BENCHMARK_SIZE;
+        size *= MEMORY_BENCHMARK_STEP)
+    {
+        size_t count = MEMORY_BENCHMARK_BYTES / size;
+
+        uint64_t start = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < count; ++i)
+        {
+            memcpy(destination, source, size);
+        }
+        uint64_t copied = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < count; ++i)
+        {
+            memset(destination, (int) i, size);
+        }
+        uint64_t set = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < count; ++i)
+        {
+            memmove(source + MEMORY_BENCHMARK_SHIFT, source, size);
+        }
+        uint64_t end = cpu_read_timestamp_counter();
+
+        terminal_write_string(sitoa(size, str, 10));
+        write_throughput(" B: memcpy ", count * size, copied - start);
+        write_throughput(", memset ", count * size, set - copied);
+        write_throughput(", memmove ", count * size, end - set);
+        terminal_write_string("\n");
+    }
+}
+
+static void benchmark_string_functions(void)
+{
+    terminal_write_string("\nString functions (bytes/cycle)\n");
+
+    char* string = malloc(STRING_BENCHMARK_LENGTH);
+    char* copy = malloc(STRING_BENCHMARK_LENGTH);
+
+    if (string == NULL || copy == NULL)
+    {
+        free(string);
+        free(copy);
+        terminal_write_string("Out of memory\n");
+        return;
+    }
+
+    /* No character matches what the searches look for, so every call
+     * scans the whole string. */
+    memset(string, 'a', STRING_BENCHMARK_LENGTH - 1);
+    string[STRING_BENCHMARK_LENGTH - 1] = '\0';
+    memcpy(copy, string, STRING_BENCHMARK_LENGTH);
+
+    /* See benchmark_memory_functions. */
+    const Simd_Functions* held = simd_begin();
+
+    terminal_write_string("Scalar\n");
+    measure_string_functions(string, copy);
+
+    if (held != NULL)
+    {
+        simd_end();
+
+        terminal_write_string("Vector\n");
+        measure_string_functions(string, copy);
+    }
+
+    free(string);
+    free(copy);
+}
+
+static void measure_string_functions(const char* string, const char* copy)
+{
+    char str[33];
+    volatile size_t sink = 0;
+
+    for (size_t length = 4;
+        length < STRING_BENCHMARK_LENGTH;
+        length *= MEMORY_BENCHMARK_STEP)
+    {
+        /* Each length is measured at the end of the string, so that the
+         * scans stop at its terminator. */
+        const char* start = string + (STRING_BENCHMARK_LENGTH - 1 - length);
+        const char* other = copy + (STRING_BENCHMARK_LENGTH - 1 - length);
+        size_t count = STRING_BENCHMARK_BYTES / length;
+
+        uint64_t begin = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < count; ++i)
+        {
+            sink += strlen(start);
+        }
+        uint64_t measured_strlen = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < count; ++i)
+        {
+            sink += (size_t) strchr(start, 'b');
+        }
+        uint64_t measured_strchr = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < count; ++i)
+        {
+            sink += (size_t) memchr(start, 'b', length);
+        }
+        uint64_t measured_memchr = cpu_read_timestamp_counter();
+        for (size_t i = 0; i < count; ++i)
+        {
+            sink += (size_t) memcmp(start, other, length);
+        }
+        uint64_t end = cpu_read_timestamp_counter();
+
+        terminal_write_string(sitoa(length, str, 10));
+        write_throughput(
+            " B: strlen ",
+            count * length,
+            measured_strlen - begin);
+        write_throughput(
+            ", strchr ",
+            count * length,
+            measured_strchr - measured_strlen);
+        write_throughput(
+            ", memchr ",
+            count * length,
+            measured_memchr - measured_strchr);
+        write_throughput(", memcmp ", count * length, end - measured_memchr);
+        terminal_write_string("\n");
+    }
+
+    (void) sink;
+}
@@ -35,6 +35,8 @@
 #include <boot/kernel/interrupts/isr.h>
 #include <boot/kernel/kernel.h>
 #include <boot/kernel/gdt/gdt.h>
+#include <boot/kernel/random/random.h>
+#include <boot/kernel/simd/simd.h>
 #include <boot/ui/terminal.h>
 
 static void gdt_initialize(void);
@@ -47,6 +49,12 @@ void kernel_initialize(void)
 
     gdt_initialize();
     idt_initialize();
+
+    /* Switches the string functions to vector code where supported. */
+    simd_initialize();
+
+    /* Seeds the per-CPU generators before anything randomizes. */
+    random_initialize();
 }
 
 static void gdt_initialize(void)
@@ -54,7 +62,10 @@ static void gdt_initialize(void)
     Gdt_Descriptor gdt_descriptor;
     Gdt_Descriptor_Source gdt_descriptor_src;
 
-    Gdt_Entry gdt_entry[3];
+    /* The tables must outlive this function, since the CPU keeps reading
+     * them whenever a segment register is loaded or an interrupt is
+     * delivered. */
+    static Gdt_Entry gdt_entry[3];
     Gdt_Entry_Source gdt_entry_src[3];
 
     gdt_descriptor_src.offset = (uint32_t) &gdt_entry[0];
@@ -99,7 +110,8 @@ static void idt_initialize(void)
     Idt_Descriptor idt_descriptor;
     Idt_Descriptor_Source idt_descriptor_src;
 
-    Idt_Entry idt_entry[256];
+    /* See gdt_initialize. */
+    static Idt_Entry idt_entry[256];
     Idt_Entry_Source idt_entry_src[256];
 
     idt_descriptor_src.offset = (uint32_t) &idt_entry[0];
@@ -20,10 +20,13 @@
  */
 
 #include <float.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+#include <ctype.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
@@ -32,28 +35,909 @@
 #include <boot/kernel/kernel.h>
 #include <boot/kernel/kernel_test.h>
 #include <boot/kernel/gdt/gdt.h>
+#include <boot/kernel/memory/arena.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/vmalloc.h>
+#include <boot/kernel/random/random.h>
+#include <boot/kernel/simd/simd.h>
+#include <boot/kernel/string_builder/string_builder.h>
+#include <boot/ui/terminal.h>
 
 static void test(void)
 {
-	char tchar_true = 't';
-	char tchar_false = 'f';
-	char* tret = malloc(sizeof(char) * 2);
-	tret[0] = tchar_false;
-	tret[1] = '\0';
+	bool passed = false;
 
-	char* tstr = malloc(200);
-	tstr = strcpy(tstr, "");
-	terminal_write_string(tstr);
 	if (1)
 	{
-		tret[0] = tchar_true;
+		passed = true;
 	}
 
-	char* tretstr = malloc(sizeof(char) * 200);
-	tretstr = strcpy(tretstr, "\nTest returned: ");
-	tretstr = strcat(tretstr, tret);
-	tretstr = strcat(tretstr, "\n");
-	terminal_write_string(tretstr);
+	printf("\nTest returned: %c\n", passed ? 't' : 'f');
+}
+
+/**
+ * @brief Number of random cases run by the string function test.
+ */
+#define STRING_TEST_CASES 20000
+
+/**
+ * @brief Longest string or object used by the string function test. Long
+ * enough to reach the vector code.
+ */
+#define STRING_TEST_LENGTH 300
+
+static uint8_t string_test_a[STRING_TEST_LENGTH + 64];
+static uint8_t string_test_b[STRING_TEST_LENGTH + 64];
+
+static size_t reference_strlen(const char* cs)
+{
+	size_t i = 0;
+	while (cs[i] != '\0')
+	{
+		++i;
+	}
+	return (i);
+}
+
+static char* reference_strchr(const char* cs, int c)
+{
+	for (;; ++cs)
+	{
+		if (*cs == (char) c)
+		{
+			return ((char*) cs);
+		}
+		if (*cs == '\0')
+		{
+			return (NULL);
+		}
+	}
+}
+
+static void* reference_memchr(const void* cs, int c, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (((const uint8_t*) cs)[i] == (uint8_t) c)
+		{
+			return ((void*) &((const uint8_t*) cs)[i]);
+		}
+	}
+	return (NULL);
+}
+
+static int reference_memcmp(const void* cs, const void* ct, size_t n)
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		uint8_t a = ((const uint8_t*) cs)[i];
+		uint8_t b = ((const uint8_t*) ct)[i];
+
+		if (a != b)
+		{
+			return ((a > b) ? 1 : -1);
+		}
+	}
+	return (0);
+}
+
+static const uint8_t* reference_memmem(
+	const uint8_t* cs, size_t n, const uint8_t* ct, size_t m)
+{
+	for (size_t i = 0; i + m <= n; ++i)
+	{
+		if (reference_memcmp(&cs[i], ct, m) == 0)
+		{
+			return (&cs[i]);
+		}
+	}
+	return (NULL);
+}
+
+/**
+ * @brief Longest needle used by the search test. Long enough to take the
+ * two-way search at several periods.
+ */
+#define SEARCH_TEST_NEEDLE 40
+
+static uint8_t search_test_needle[SEARCH_TEST_NEEDLE + 1];
+
+static uint32_t next_test_random(uint32_t* state)
+{
+	*state = (*state * 1103515245) + 12345;
+	return (*state >> 16);
+}
+
+/**
+ * @brief Checks memmem and strstr against a naive search, over random,
+ * periodic and nearly uniform texts with needles found in them, needles
+ * that miss by their last byte and needles of every length up to
+ * SEARCH_TEST_NEEDLE, including none.
+ *
+ * @return Name of the first function that disagreed, or NULL.
+ */
+static const char* test_search_cases(void)
+{
+	uint32_t state = 7;
+
+	for (size_t i = 0; i < STRING_TEST_CASES; ++i)
+	{
+		size_t n = next_test_random(&state) % STRING_TEST_LENGTH;
+		uint8_t* a = &string_test_a[next_test_random(&state) % 32];
+		uint8_t* b = search_test_needle;
+
+		/* Half the needles are short enough for the packed search. */
+		size_t m = next_test_random(&state)
+			% (((i / 2) % 2 != 0) ? 8 : SEARCH_TEST_NEEDLE + 1);
+
+		/* Every other run of cases puts NULs in the text, which memmem
+		 * must search past and strstr must stop at. */
+		uint8_t base = ((i / 4) % 2 != 0) ? 0 : 'a';
+
+		if ((i % 4) == 2)
+		{
+			/* Repeats a pattern such as "aab", with rare breaks. */
+			uint8_t pattern[3];
+			size_t period = 1 + (next_test_random(&state) % 3);
+
+			for (size_t j = 0; j < period; ++j)
+			{
+				pattern[j] = base + (next_test_random(&state) % 2);
+			}
+			for (size_t j = 0; j < n; ++j)
+			{
+				a[j] = ((next_test_random(&state) % 64) == 0)
+					? base + 2 : pattern[j % period];
+			}
+		}
+		else if ((i % 4) == 3)
+		{
+			/* Nearly every position of "aaa...b" starts a partial match. */
+			for (size_t j = 0; j < n; ++j)
+			{
+				a[j] = base + ((next_test_random(&state) % 32) == 0);
+			}
+		}
+		else
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				a[j] = base + (next_test_random(&state) % 3);
+			}
+		}
+		a[n] = '\0';
+
+		if ((i % 4) != 1 && m <= n)
+		{
+			/* Takes the needle from the text, and sometimes changes its
+			 * last byte so that it only nearly matches. */
+			memcpy(b, &a[next_test_random(&state) % (n - m + 1)], m);
+
+			if (m != 0 && (next_test_random(&state) % 2) != 0)
+			{
+				b[m - 1] = base + ((b[m - 1] - base + 1) % 3);
+			}
+		}
+		else
+		{
+			for (size_t j = 0; j < m; ++j)
+			{
+				b[j] = base + (next_test_random(&state) % 3);
+			}
+		}
+		b[m] = '\0';
+
+		if (memmem(a, n, b, m) != reference_memmem(a, n, b, m))
+		{
+			return ("memmem");
+		}
+
+		const uint8_t* expected = reference_memmem(
+			a, reference_strlen((char*) a), b, reference_strlen((char*) b));
+
+		if (strstr((char*) a, (char*) b) != (char*) expected)
+		{
+			return ("strstr");
+		}
+	}
+
+	return (NULL);
+}
+
+/**
+ * @brief Cases for strspn, strcspn and strpbrk, with the lengths of the
+ * accepted and rejected spans. Sets with high bit characters catch values
+ * used as signed indices.
+ */
+static const struct
+{
+	const char* string;
+	const char* set;
+	size_t accepted;
+	size_t rejected;
+} set_test_cases[] =
+{
+	{"", "", 0, 0},
+	{"", "abc", 0, 0},
+	{"abc", "", 0, 3},
+	{"aabbcd", "ab", 4, 0},
+	{"xyzab", "ab", 0, 3},
+	{"xyz", "ab", 0, 3},
+	{"\x80\xff" "a\xfe", "\xff\x80", 2, 0},
+	{"ab\xe9" "cd", "\xe9", 0, 2},
+	{"abc\x7f", "\x80\xe1\xe2\xff", 0, 4},
+	{"\x7f\x80", "\x7f", 1, 0}
+};
+
+static bool check_token(const char* token, const char* expected)
+{
+	if (expected == NULL)
+	{
+		return (token == NULL);
+	}
+	return (token != NULL && strcmp(token, expected) == 0);
+}
+
+/**
+ * @brief Checks strspn, strcspn and strpbrk against set_test_cases, and
+ * strtok across calls.
+ *
+ * @return Name of the first function that failed, or NULL.
+ */
+static const char* test_set_cases(void)
+{
+	for (size_t i = 0; i < sizeof(set_test_cases) / sizeof(set_test_cases[0]);
+		++i)
+	{
+		const char* string = set_test_cases[i].string;
+		const char* set = set_test_cases[i].set;
+		size_t rejected = set_test_cases[i].rejected;
+
+		if (strspn(string, set) != set_test_cases[i].accepted)
+		{
+			return ("strspn");
+		}
+		if (strcspn(string, set) != rejected)
+		{
+			return ("strcspn");
+		}
+		if (strpbrk(string, set)
+			!= ((string[rejected] != '\0') ? &string[rejected] : NULL))
+		{
+			return ("strpbrk");
+		}
+	}
+
+	/* Runs of delimiters, at either end and between tokens, yield no empty
+	 * tokens, and the end stays reported until a new string is given. */
+	char runs[] = ", ,a,, b\xff\xff" "c, d e ,,";
+	char changed[] = "a,b c";
+	char empty[] = "";
+	char delimiters[] = ",,,";
+	char whole[] = "abc";
+
+	if (!check_token(strtok(runs, " ,\xff"), "a")
+		|| !check_token(strtok(NULL, " ,\xff"), "b")
+		|| !check_token(strtok(NULL, " ,\xff"), "c")
+		|| !check_token(strtok(NULL, " ,\xff"), "d")
+		|| !check_token(strtok(NULL, " ,\xff"), "e")
+		|| !check_token(strtok(NULL, " ,\xff"), NULL)
+		|| !check_token(strtok(NULL, " ,\xff"), NULL)
+		|| !check_token(strtok(changed, ","), "a")
+		|| !check_token(strtok(NULL, " "), "b")
+		|| !check_token(strtok(NULL, " "), "c")
+		|| !check_token(strtok(NULL, " "), NULL)
+		|| !check_token(strtok(empty, ","), NULL)
+		|| !check_token(strtok(NULL, ","), NULL)
+		|| !check_token(strtok(delimiters, ","), NULL)
+		|| !check_token(strtok(whole, ""), "abc")
+		|| !check_token(strtok(NULL, ""), NULL))
+	{
+		return ("strtok");
+	}
+
+	return (NULL);
+}
+
+/**
+ * @brief Checks strspn, strcspn, strpbrk and strtok on fixed cases, then
+ * strlen, strchr, memchr and memcmp against byte-at-a-time references,
+ * over random lengths, alignments and contents, then memmem and strstr
+ * against a naive search.
+ *
+ * @return Name of the first function that disagreed, or NULL.
+ */
+static const char* test_string_cases(void)
+{
+	const char* failed = test_set_cases();
+
+	if (failed != NULL)
+	{
+		return (failed);
+	}
+
+	uint32_t state = 1;
+
+	for (size_t i = 0; i < STRING_TEST_CASES; ++i)
+	{
+		state = (state * 1103515245) + 12345;
+		size_t n = (state >> 8) % STRING_TEST_LENGTH;
+		size_t offset_a = (state >> 20) % 32;
+		size_t offset_b = (state >> 25) % 32;
+		uint8_t* a = &string_test_a[offset_a];
+		uint8_t* b = &string_test_b[offset_b];
+
+		/* A small alphabet makes matches likely at every position. */
+		for (size_t j = 0; j < n; ++j)
+		{
+			state = (state * 1103515245) + 12345;
+			a[j] = 1 + ((state >> 16) % 4);
+			b[j] = a[j];
+		}
+		a[n] = '\0';
+		b[n] = '\0';
+
+		int c = (int) (i % 6);
+
+		if (n != 0 && (i % 2) != 0)
+		{
+			b[(state >> 4) % n] ^= 0x80;
+		}
+
+		if (strlen((char*) a) != reference_strlen((char*) a))
+		{
+			return ("strlen");
+		}
+		if (strchr((char*) a, c) != reference_strchr((char*) a, c))
+		{
+			return ("strchr");
+		}
+		if (memchr(a, c, n) != reference_memchr(a, c, n))
+		{
+			return ("memchr");
+		}
+		if (memcmp(a, b, n) != reference_memcmp(a, b, n))
+		{
+			return ("memcmp");
+		}
+	}
+
+	return (test_search_cases());
+}
+
+static void test_string_functions(void)
+{
+	/* Holding the vector registers makes the string functions fall back
+	 * to their scalar code, so both paths get checked. */
+	const Simd_Functions* held = simd_begin();
+	const char* scalar = test_string_cases();
+	const char* vector = NULL;
+
+	if (held != NULL)
+	{
+		simd_end();
+		vector = test_string_cases();
+	}
+
+	terminal_write_string("\nString functions: ");
+	if (scalar == NULL && vector == NULL)
+	{
+		terminal_write_string("passed\n");
+		return;
+	}
+
+	terminal_write_string("FAILED (");
+	terminal_write_string((scalar != NULL) ? scalar : vector);
+	terminal_write_string((scalar != NULL) ? ", scalar)\n" : ", vector)\n");
+}
+
+/**
+ * @brief Fails the ctype test unless both the macro and the function form
+ * of a predicate give the expected truth for c.
+ */
+#define CHECK_CTYPE(predicate, expected) \
+	if (((predicate(c) != 0) != (expected)) \
+		|| (((predicate)(c) != 0) != (expected))) \
+	{ \
+		return (#predicate); \
+	}
+
+/**
+ * @brief Checks every predicate, and tolower and toupper, on EOF and every
+ * unsigned char value against classes written out from ASCII.
+ *
+ * @return Name of the first function that disagreed, or NULL.
+ */
+static const char* test_ctype_cases(void)
+{
+	for (int c = EOF; c <= UCHAR_MAX; ++c)
+	{
+		bool upper = (c >= 'A' && c <= 'Z');
+		bool lower = (c >= 'a' && c <= 'z');
+		bool digit = (c >= '0' && c <= '9');
+		bool graph = (c > ' ' && c < 0x7F);
+
+		CHECK_CTYPE(isalnum, upper || lower || digit);
+		CHECK_CTYPE(isalpha, upper || lower);
+		CHECK_CTYPE(iscntrl, (c >= 0 && c < ' ') || c == 0x7F);
+		CHECK_CTYPE(isdigit, digit);
+		CHECK_CTYPE(isgraph, graph);
+		CHECK_CTYPE(islower, lower);
+		/* Tab and newline do not print; only the space character joins
+		 * the graphic ones. */
+		CHECK_CTYPE(isprint, graph || c == ' ');
+		CHECK_CTYPE(ispunct, graph && !upper && !lower && !digit);
+		CHECK_CTYPE(isspace, c == ' ' || (c >= '\t' && c <= '\r'));
+		CHECK_CTYPE(isupper, upper);
+		CHECK_CTYPE(isxdigit, digit || (c >= 'A' && c <= 'F')
+			|| (c >= 'a' && c <= 'f'));
+
+		/* Characters that are not converted come back unchanged. */
+		if (tolower(c) != (upper ? c - 'A' + 'a' : c))
+		{
+			return ("tolower");
+		}
+		if (toupper(c) != (lower ? c - 'a' + 'A' : c))
+		{
+			return ("toupper");
+		}
+	}
+
+	return (NULL);
+}
+
+static void test_ctype(void)
+{
+	const char* failed = test_ctype_cases();
+
+	terminal_write_string("\nCtype: ");
+	if (failed == NULL)
+	{
+		terminal_write_string("passed\n");
+		return;
+	}
+
+	terminal_write_string("FAILED (");
+	terminal_write_string(failed);
+	terminal_write_string(")\n");
+}
+
+/**
+ * @brief Strings that strtod must convert to exact bits: each fast path,
+ * halfway cases, the subnormal boundary and overflow.
+ */
+static const struct
+{
+	const char* string;
+	uint64_t bits;
+} strtod_test_cases[] =
+{
+	{"3.14", 0x40091EB851EB851FULL},
+	{"-0.5", 0xBFE0000000000000ULL},
+	{"1e23", 0x44B52D02C7E14AF6ULL},
+	{"123456789012345e22", 0x476DB89CAFCCD3A9ULL},
+	{"9007199254740993", 0x4340000000000000ULL},
+	{"7.038531e-26", 0x3AB5C87FB0000000ULL},
+	{"2.2250738585072011e-308", 0x000FFFFFFFFFFFFFULL},
+	{"4.9e-324", 0x0000000000000001ULL},
+	{"2.4e-324", 0x0000000000000000ULL},
+	{"1.7976931348623159e308", 0x7FF0000000000000ULL},
+	{
+		"1.00000000000000011102230246251565404236316680908203125",
+		0x3FF0000000000000ULL
+	},
+	{
+		"1.00000000000000011102230246251565404236316680908203126",
+		0x3FF0000000000001ULL
+	}
+};
+
+static void test_strtod(void)
+{
+	const size_t count =
+		sizeof(strtod_test_cases) / sizeof(strtod_test_cases[0]);
+
+	terminal_write_string("\nstrtod: ");
+	for (size_t i = 0; i < count; ++i)
+	{
+		double val = strtod(strtod_test_cases[i].string, NULL);
+		uint64_t bits;
+
+		memcpy(&bits, &val, sizeof(bits));
+		if (bits != strtod_test_cases[i].bits)
+		{
+			terminal_write_string("FAILED (");
+			terminal_write_string(strtod_test_cases[i].string);
+			terminal_write_string(")\n");
+			return;
+		}
+	}
+	terminal_write_string("passed\n");
+}
+
+/**
+ * @brief Strings that strtol must convert, with the value and the number
+ * of characters it consumes.
+ */
+static const struct
+{
+	const char* string;
+	int base;
+	long val;
+	size_t length;
+} strtol_test_cases[] =
+{
+	{"  -12345678x", 10, -12345678, 11},
+	{"2147483647", 10, 2147483647, 10},
+	{"2147483648", 10, 2147483647, 10},
+	{"-2147483648", 0, -2147483647 - 1, 11},
+	{"0x1f", 0, 31, 4},
+	{"0xg", 16, 0, 1},
+	{"0777", 0, 511, 4},
+	{"zz", 36, 1295, 2},
+	{"+", 10, 0, 0}
+};
+
+static void test_strtol(void)
+{
+	const size_t count =
+		sizeof(strtol_test_cases) / sizeof(strtol_test_cases[0]);
+
+	terminal_write_string("\nstrtol: ");
+	for (size_t i = 0; i < count; ++i)
+	{
+		char* end;
+		long val = strtol(
+			strtol_test_cases[i].string,
+			&end,
+			strtol_test_cases[i].base);
+
+		if ((val != strtol_test_cases[i].val)
+			|| ((size_t) (end - strtol_test_cases[i].string)
+				!= strtol_test_cases[i].length))
+		{
+			terminal_write_string("FAILED (");
+			terminal_write_string(strtol_test_cases[i].string);
+			terminal_write_string(")\n");
+			return;
+		}
+	}
+	terminal_write_string("passed\n");
+}
+
+/**
+ * @brief Number of keys sorted by the sort test, enough to reach the
+ * partitioning code many times over.
+ */
+#define SORT_TEST_KEYS 2000
+
+static uint32_t sort_test_keys[SORT_TEST_KEYS];
+static uint32_t sort_test_copy[SORT_TEST_KEYS];
+
+static int compare_test_keys(const void* a, const void* b)
+{
+	uint32_t x = *(const uint32_t*) a;
+	uint32_t y = *(const uint32_t*) b;
+
+	return ((x > y) - (x < y));
+}
+
+static void test_sort(void)
+{
+	uint32_t state = 1;
+
+	/* Few distinct keys, so runs of equal keys get partitioned too. */
+	for (size_t i = 0; i < SORT_TEST_KEYS; ++i)
+	{
+		state = (state * 1103515245) + 12345;
+		sort_test_keys[i] = (state >> 16) % 500;
+		sort_test_copy[i] = sort_test_keys[i];
+	}
+
+	qsort(sort_test_keys, SORT_TEST_KEYS, sizeof(uint32_t),
+		compare_test_keys);
+	qsort_uint32(sort_test_copy, SORT_TEST_KEYS);
+
+	terminal_write_string("\nSort: ");
+	for (size_t i = 0; i < SORT_TEST_KEYS; ++i)
+	{
+		uint32_t key = sort_test_keys[i];
+		const uint32_t* found = bsearch(&key, sort_test_keys,
+			SORT_TEST_KEYS, sizeof(uint32_t), compare_test_keys);
+
+		if (((i > 0) && (sort_test_keys[i - 1] > key))
+			|| (sort_test_copy[i] != key)
+			|| (found == NULL) || (*found != key)
+			|| (bsearch_uint32(key, sort_test_copy, SORT_TEST_KEYS)
+				== NULL))
+		{
+			terminal_write_string("FAILED\n");
+			return;
+		}
+	}
+	terminal_write_string("passed\n");
+}
+
+/**
+ * @brief First outputs of xoshiro128** seeded with 1 through SplitMix64,
+ * from the reference implementations.
+ */
+static const uint32_t random_test_outputs[4] =
+{
+	0x650941BA, 0x54D30301, 0x25D2F321, 0x3FABDCA9
+};
+
+static void test_random(void)
+{
+	Random random;
+	bool passed = true;
+
+	random_seed(&random, 1);
+	for (size_t i = 0; i < 4; ++i)
+	{
+		passed &= (random_next(&random) == random_test_outputs[i]);
+	}
+
+	/* Bounded draws stay in range and reach both ends of it. */
+	bool low = false;
+	bool high = false;
+
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		uint32_t value = random_next_below(&random, 7);
+
+		passed &= (value < 7);
+		low |= (value == 0);
+		high |= (value == 6);
+	}
+	passed &= (low && high);
+
+	/* rand follows the same sequence after srand(1). */
+	srand(1);
+	passed &= ((uint32_t) rand() == (random_test_outputs[0] >> 1));
+
+	terminal_write_string(passed ? "\nRandom: passed\n"
+		: "\nRandom: FAILED\n");
+}
+
+/**
+ * @brief Checks one snprintf result against the expected output and length.
+ */
+static bool check_format(const char* buffer, int ret, const char* expected)
+{
+	return ((strcmp(buffer, expected) == 0)
+		&& (ret == (int) strlen(expected)));
+}
+
+static void test_printf(void)
+{
+	char buffer[96];
+	bool passed = true;
+	int ret;
+
+	ret = snprintf(buffer, sizeof(buffer), "%d|%i|%u", -42, 7, 4000000000U);
+	passed &= check_format(buffer, ret, "-42|7|4000000000");
+
+	ret = snprintf(buffer, sizeof(buffer), "%x|%X|%#x|%o|%#o|%#x",
+		0xBEEFU, 0xBEEFU, 255U, 8U, 8U, 0U);
+	passed &= check_format(buffer, ret, "beef|BEEF|0xff|10|010|0");
+
+	ret = snprintf(buffer, sizeof(buffer), "[%5d|%-5d|%05d|%+d|% d|%-+5d]",
+		42, 42, -42, 42, 42, 42);
+	passed &= check_format(buffer, ret, "[   42|42   |-0042|+42| 42|+42  ]");
+
+	ret = snprintf(buffer, sizeof(buffer), "%.3d|%8.3d|%-6.3d|%.0d|",
+		7, -7, 7, 0);
+	passed &= check_format(buffer, ret, "007|    -007|007   ||");
+
+	ret = snprintf(buffer, sizeof(buffer), "%lld|%llu|%llx",
+		INT64_MIN, UINT64_MAX, 0x123456789ABCDEFULL);
+	passed &= check_format(buffer, ret,
+		"-9223372036854775808|18446744073709551615|123456789abcdef");
+
+	ret = snprintf(buffer, sizeof(buffer), "%zu|%hhd|%hu|%ld",
+		(size_t) 123, 300, 70000, -1L);
+	passed &= check_format(buffer, ret, "123|44|4464|-1");
+
+	ret = snprintf(buffer, sizeof(buffer), "%s|%.2s|%6s|%-6s|%c|%%",
+		"abc", "abc", "abc", "abc", 'z');
+	passed &= check_format(buffer, ret, "abc|ab|   abc|abc   |z|%");
+
+	ret = snprintf(buffer, sizeof(buffer), "%*d|%-*d|%.*d|%*d",
+		4, 1, 4, 1, 3, 1, -3, 1);
+	passed &= check_format(buffer, ret, "   1|1   |001|1  ");
+
+	ret = snprintf(buffer, sizeof(buffer), "%p|%p",
+		(void*) 0x1000, (void*) NULL);
+	passed &= check_format(buffer, ret, "0x1000|0x0");
+
+	/* Output that does not fit is counted but cut off. */
+	ret = snprintf(buffer, 4, "%d", 123456);
+	passed &= (ret == 6) && (strcmp(buffer, "123") == 0);
+	passed &= (snprintf(NULL, 0, "%s%d", "abc", 10) == 5);
+
+	printf("\nprintf: %s\n", passed ? "passed" : "FAILED");
+}
+
+static void test_string_builder(void)
+{
+	char buffer[16];
+	bool passed = true;
+
+	/* The bounded and end-returning string primitives. */
+	passed &= (stpcpy(buffer, "abc") == buffer + 3);
+	passed &= (strlcpy(buffer, "hello", 4) == 5)
+		&& (strcmp(buffer, "hel") == 0);
+	passed &= (strlcat(buffer, "lo world", 8) == 11)
+		&& (strcmp(buffer, "hello w") == 0);
+	passed &= (strcmp(strncat(strcpy(buffer, "ab"), "cdef", 2), "abcd") == 0);
+
+	/* A heap builder grows and keeps every piece. */
+	String_Builder builder;
+	char expected[8];
+	size_t length = 0;
+
+	string_builder_initialize(&builder);
+	for (int i = 0; i < 200; ++i)
+	{
+		string_builder_append_fmt(&builder, "%d,", i);
+		string_builder_append_char(&builder, '-');
+		length += (size_t) snprintf(expected, sizeof(expected), "%d,-", i);
+	}
+	passed &= (string_builder_get_length(&builder) == length)
+		&& !builder.truncated;
+	passed &= (memcmp(string_builder_get_string(&builder), "0,-1,-2,-", 9)
+		== 0);
+	passed &= (strcmp(string_builder_get_string(&builder) + length - 5,
+		"199,-") == 0);
+	string_builder_destroy(&builder);
+
+	/* A reservation is the only allocation. */
+	passed &= string_builder_reserve(&builder, 100);
+
+	const char* data = string_builder_get_string(&builder);
+
+	for (int i = 0; i < 10; ++i)
+	{
+		string_builder_append(&builder, "0123456789");
+	}
+	passed &= (string_builder_get_string(&builder) == data)
+		&& (string_builder_get_length(&builder) == 100);
+	string_builder_destroy(&builder);
+
+	/* A fixed buffer is cut off instead of overflowing. */
+	string_builder_initialize_buffer(&builder, buffer, 8);
+	string_builder_append(&builder, "abc");
+	string_builder_append_fmt(&builder, "%d", 12345);
+	passed &= (strcmp(buffer, "abc1234") == 0) && builder.truncated;
+
+	terminal_write_string(passed ? "\nString builder: passed\n"
+		: "\nString builder: FAILED\n");
+}
+
+static void test_arena(void)
+{
+	Arena* arena = arena_create();
+
+	if (arena == NULL)
+	{
+		terminal_write_string("\nArena: FAILED (no memory)\n");
+		return;
+	}
+
+	bool passed = true;
+
+	/* Sizes whose chunk would wrap around the address space are refused,
+	 * and leave the arena usable. */
+	passed &= (arena_allocate(arena, SIZE_MAX) == NULL);
+	passed &= (arena_allocate(arena, SIZE_MAX - 16) == NULL);
+	passed &= (arena_allocate(arena, SIZE_MAX - sizeof(Arena_Chunk)) == NULL);
+	passed &= (arena_allocate_aligned(arena, SIZE_MAX - 4096, 4096) == NULL);
+
+	uint8_t* small = arena_allocate(arena, 64);
+	uint8_t* large = arena_allocate(arena, 2 * ARENA_CHUNK_SIZE);
+
+	passed &= (small != NULL) && (large != NULL);
+	if (passed)
+	{
+		memset(small, 0xAA, 64);
+		memset(large, 0x55, 2 * ARENA_CHUNK_SIZE);
+		passed &= (small[63] == 0xAA);
+		passed &= ((large + (2 * ARENA_CHUNK_SIZE) <= small)
+			|| (small + 64 <= large));
+	}
+
+	arena_destroy(arena);
+
+	terminal_write_string(passed ? "\nArena: passed\n"
+		: "\nArena: FAILED\n");
+}
+
+/**
+ * @brief Size the realloc test grows its buffer to. Larger than the largest
+ * buddy block, so that the buffer has to end up in the vmalloc window.
+ */
+#define REALLOC_TEST_SIZE (8 * 1024 * 1024)
+
+static void test_realloc(void)
+{
+	uint32_t* buffer = NULL;
+	size_t count = 0;
+	bool passed = true;
+
+	/* Every step keeps what the buffer held, whether it grew in place, was
+	 * copied, or had its pages remapped. */
+	for (size_t size = 1024; size <= REALLOC_TEST_SIZE; size *= 2)
+	{
+		uint32_t* grown = realloc(buffer, size);
+
+		if (grown == NULL)
+		{
+			passed = false;
+			break;
+		}
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			passed &= (grown[i] == (uint32_t) i * 2654435761U);
+		}
+
+		buffer = grown;
+		for (; count < size / sizeof(uint32_t); ++count)
+		{
+			buffer[count] = (uint32_t) count * 2654435761U;
+		}
+	}
+
+	passed &= vmalloc_contains(buffer);
+
+	/* Shrinking keeps the start of the buffer. */
+	buffer = realloc(buffer, 12 * 1024);
+	passed &= (buffer != NULL) && (buffer[3071] == 3071U * 2654435761U);
+
+	free(buffer);
+
+	terminal_write_string(passed ? "\nRealloc: passed\n"
+		: "\nRealloc: FAILED\n");
+}
+
+/**
+ * @brief Longest string the guarded string test places against the guard
+ * page of a vmalloc buffer.
+ */
+#define GUARD_TEST_LENGTH 80
+
+static void test_guarded_strings(void)
+{
+	char* buffer = vmalloc_allocate(FRAME_ALLOCATOR_FRAME_SIZE);
+	char* end = buffer + FRAME_ALLOCATOR_FRAME_SIZE;
+	bool passed = (buffer != NULL);
+
+	/* Each string ends just before the guard page after the buffer, so
+	 * that a search given a larger bound faults unless it stops at the
+	 * terminator. Every length puts the string at another alignment. */
+	for (size_t length = 0; passed && length < GUARD_TEST_LENGTH; ++length)
+	{
+		char* s = end - length - 1;
+		char joined[GUARD_TEST_LENGTH + 8] = "x";
+		char formatted[GUARD_TEST_LENGTH + 8];
+
+		memset(s, 'a', length);
+		s[length] = '\0';
+
+		passed &= (memchr(s, '\0', 2 * GUARD_TEST_LENGTH) == &s[length]);
+		passed &= (strlen(strncat(joined, s, 2 * GUARD_TEST_LENGTH))
+			== length + 1);
+		passed &= (strlcat(joined, s, sizeof(joined))
+			== 2 * length + 1);
+		passed &= (snprintf(formatted, sizeof(formatted), "%.*s",
+			2 * GUARD_TEST_LENGTH, s) == (int) length);
+	}
+
+	vmalloc_free(buffer);
+
+	terminal_write_string(passed ? "\nGuarded strings: passed\n"
+		: "\nGuarded strings: FAILED\n");
 }
 
 static void test_end(void)
@@ -72,5 +956,16 @@ void kernel_test_start(void)
 	);
 
 	test();
+	test_string_functions();
+	test_ctype();
+	test_strtod();
+	test_strtol();
+	test_sort();
+	test_random();
+	test_printf();
+	test_string_builder();
+	test_arena();
+	test_realloc();
+	test_guarded_strings();
 	test_end();
 }
@@ -29,6 +29,6 @@
 /**
  * Starts test.
  */
-void test_start(void);
+void kernel_test_start(void);
 
 #endif /* TEST_HPP_INCLUDED */
@@ -27,158 +27,96 @@
 
 #include <globals.h>
 
-int isalnum(int c)
+/**
+ * @brief Difference between a lower-case letter and its upper-case form.
+ */
+#define CASE_DIFFERENCE ('a' - 'A')
+
+const unsigned char _ctype_table[256] =
 {
-    if ((isalpha(c) != 0) || (isdigit(c) != 0))
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    [0 ... '\t' - 1] = _CTYPE_CNTRL,
+    ['\t' ... '\r'] = _CTYPE_CNTRL | _CTYPE_SPACE,
+    ['\r' + 1 ... ' ' - 1] = _CTYPE_CNTRL,
+    [' '] = _CTYPE_SPACE | _CTYPE_BLANK,
+    ['!' ... '/'] = _CTYPE_PUNCT,
+    ['0' ... '9'] = _CTYPE_DIGIT | _CTYPE_XDIGIT,
+    [':' ... '@'] = _CTYPE_PUNCT,
+    ['A' ... 'F'] = _CTYPE_UPPER | _CTYPE_XDIGIT,
+    ['G' ... 'Z'] = _CTYPE_UPPER,
+    ['[' ... '`'] = _CTYPE_PUNCT,
+    ['a' ... 'f'] = _CTYPE_LOWER | _CTYPE_XDIGIT,
+    ['g' ... 'z'] = _CTYPE_LOWER,
+    ['{' ... '~'] = _CTYPE_PUNCT,
+    [127] = _CTYPE_CNTRL
+};
+
+/* The names are parenthesized so that the macros in ctype.h do not expand
+ * here. */
+
+int (isalnum)(int c)
+{
+    return (isalnum(c));
 }
 
-int isalpha(int c)
+int (isalpha)(int c)
 {
-    if ((isupper(c) != 0) || (islower(c) != 0))
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (isalpha(c));
 }
 
-int iscntrl(int c)
+int (iscntrl)(int c)
 {
-    if ((c >= 0 && c <= 31) || (c == 127))
-    {
-        return (1);
-    }
-    else
-    {
-        return 0;
-    }
+    return (iscntrl(c));
 }
 
-int isdigit(int c)
+int (isdigit)(int c)
 {
-    if (c >= 48 && c <= 57)
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (isdigit(c));
 }
 
-int isgraph(int c)
+int (isgraph)(int c)
 {
-    if ((isalnum(c) != 0) || (ispunct(c) != 0))
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (isgraph(c));
 }
 
-int islower(int c)
+int (islower)(int c)
 {
-    if (c >= 97 && c <= 122)
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (islower(c));
 }
 
-int isprint(int c)
+int (isprint)(int c)
 {
-    if ((isgraph(c) != 0) || (isspace(c) != 0))
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (isprint(c));
 }
 
-int ispunct(int c)
+int (ispunct)(int c)
 {
-    if
-    (
-        (c >= 33 && c <= 47)
-        ||
-        (c >= 58 && c <= 64)
-        ||
-        (c >= 91 && c <= 96)
-        ||
-        (c >= 123 && c <= 126)
-    )
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (ispunct(c));
 }
 
-int isspace(int c)
+int (isspace)(int c)
 {
-    if ((c >= 9 && c <= 13) || (c == 32))
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (isspace(c));
 }
 
-int isupper(int c)
+int (isupper)(int c)
 {
-    if (c >= 65 && c <= 90)
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (isupper(c));
 }
 
-int isxdigit(int c)
+int (isxdigit)(int c)
 {
-    if ((isdigit(c) != 0) || (c >= 65 && c <= 70) || (c >= 97 && c <= 102))
-    {
-        return (1);
-    }
-    else
-    {
-        return (0);
-    }
+    return (isxdigit(c));
 }
 
 int tolower(int c)
 {
     if (isupper(c) != 0)
     {
-        /* Sets bit 6 of character, adding 32 to its decimal value and thus
-         * converting from upper-case to lower-case. */
-        return (BIT_SET(c, 6));
+        return (c + CASE_DIFFERENCE);
     }
     else
     {
-        return (0);
+        return (c);
     }
 }
 
@@ -186,12 +124,10 @@ int toupper(int c)
 {
     if (islower(c) != 0)
     {
-        /* Clears bit 6 of character, subtracting 32 from its decimal value
-         * and thus converting from lower-case to upper-case. */
-        return (BIT_CLEAR(c, 6));
+        return (c - CASE_DIFFERENCE);
     }
     else
     {
-        return (0);
+        return (c);
     }
 }
@@ -19,24 +19,1099 @@
  * MA 02110-1301, USA.
  */
 
+#include <limits.h>
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 #include <stdio.h>
+#include <string.h>
+
+#include <globals.h>
+#include <boot/cpu.h>
+#include <boot/kernel/spinlock.h>
+#include <boot/ui/terminal.h>
+
+/**
+ * @brief Output stream: a buffer in front of a function that takes whole
+ * runs of bytes.
+ */
+struct FILE
+{
+    /* Buffered bytes, or NULL for a stream that cannot buffer. */
+    char* buffer;
+
+    /* Size of buffer in bytes. */
+    size_t capacity;
+
+    /* Number of bytes waiting in buffer. */
+    size_t count;
+
+    /* _IOFBF, _IOLBF or _IONBF. */
+    int mode;
+
+    /* Writes bytes to the device behind the stream. */
+    void (*sink)(const char* data, size_t size);
+
+    /* Protects the buffer, which every CPU and interrupt handler shares. */
+    Spinlock lock;
+};
+
+/**
+ * @brief Locks a stream with interrupts disabled.
+ *
+ * @param stream Stream to lock.
+ *
+ * @return State to pass to unlock_stream.
+ */
+static uint32_t lock_stream(FILE* stream);
+
+/**
+ * @brief Unlocks a stream locked by lock_stream.
+ *
+ * @param stream Stream to unlock.
+ * @param state Value returned by lock_stream.
+ */
+static void unlock_stream(FILE* stream, uint32_t state);
+
+/**
+ * @brief Writes bytes to a locked stream, buffering them according to its
+ * mode.
+ *
+ * @param stream Stream to write to.
+ * @param data Bytes to write.
+ * @param size Number of bytes to write.
+ */
+static void write_locked(FILE* stream, const char* data, size_t size);
+
+/**
+ * @brief Passes the buffered bytes of a locked stream to its sink.
+ *
+ * @param stream Stream to flush.
+ */
+static void flush_locked(FILE* stream);
+
+/**
+ * @brief Conversion flag '-': pads on the right instead of the left.
+ */
+#define FORMAT_LEFT 0x01
+
+/**
+ * @brief Conversion flag '+': writes a plus sign before positive numbers.
+ */
+#define FORMAT_PLUS 0x02
+
+/**
+ * @brief Conversion flag ' ': writes a space before positive numbers.
+ */
+#define FORMAT_SPACE 0x04
+
+/**
+ * @brief Conversion flag '#': prefixes hexadecimal with "0x" and octal with
+ * "0".
+ */
+#define FORMAT_ALTERNATE 0x08
+
+/**
+ * @brief Conversion flag '0': pads numbers with zeros instead of spaces.
+ */
+#define FORMAT_ZERO 0x10
+
+/**
+ * @brief Set for %X, which writes uppercase digits and prefix.
+ */
+#define FORMAT_UPPER 0x20
 
 /**
- * @brief Directly writes a string to stdout without formatting.
+ * @brief Set for %p, which always has a "0x" prefix, even for NULL.
+ */
+#define FORMAT_POINTER 0x40
+
+/**
+ * @brief Size of the digit buffer of an integer conversion. The octal
+ * form of a 64-bit number, the longest, has 22 digits.
+ */
+#define FORMAT_DIGITS_SIZE 24
+
+/**
+ * @brief Number of padding characters written per call to the output.
+ */
+#define FORMAT_PAD_SIZE 16
+
+/**
+ * @brief Length modifier of an integer conversion.
+ */
+typedef enum Format_Length
+{
+    FORMAT_LENGTH_CHAR,
+    FORMAT_LENGTH_SHORT,
+    FORMAT_LENGTH_INT,
+    FORMAT_LENGTH_LONG,
+    FORMAT_LENGTH_LONG_LONG,
+    FORMAT_LENGTH_INTMAX,
+    FORMAT_LENGTH_SIZE,
+    FORMAT_LENGTH_PTRDIFF
+} Format_Length;
+
+/**
+ * @brief Destination of formatted output: either a caller's buffer or a
+ * locked stream.
+ */
+typedef struct Format_Output
+{
+    /* Buffer written by vsnprintf, or NULL when writing to stream. */
+    char* buffer;
+
+    /* Number of characters that fit in buffer, not counting the null
+     * terminator. */
+    size_t capacity;
+
+    /* Characters produced so far, including any that did not fit. */
+    size_t count;
+
+    /* Locked stream written by vfprintf, or NULL. */
+    FILE* stream;
+} Format_Output;
+
+/**
+ * @brief Parsed conversion specification.
+ */
+typedef struct Format_Specification
+{
+    /* FORMAT_* flag bits. */
+    unsigned int flags;
+
+    /* Minimum number of characters written. */
+    size_t width;
+
+    /* Minimum digits of a number or most characters of a string, or
+     * negative if none was given. */
+    int precision;
+} Format_Specification;
+
+/**
+ * @brief Formats arguments to an output in one pass over the format
+ * string.
+ *
+ * @param output Output to write to.
+ * @param format Format string, as described for vsnprintf.
+ * @param args Arguments to format.
+ */
+static void format_arguments(Format_Output* output, const char* format,
+    va_list args);
+
+/**
+ * @brief Reads a signed integer argument of the given length.
+ *
+ * @param args Arguments to read from.
+ * @param length Length modifier of the conversion.
+ *
+ * @return The argument, converted to intmax_t.
+ */
+static intmax_t format_read_signed(va_list* args, Format_Length length);
+
+/**
+ * @brief Reads an unsigned integer argument of the given length.
  *
- * @param str String to write. This should be null-terminated.
- * @param len Length of the string to write.
+ * @param args Arguments to read from.
+ * @param length Length modifier of the conversion.
+ *
+ * @return The argument, converted to uintmax_t.
  */
+static uintmax_t format_read_unsigned(va_list* args, Format_Length length);
+
+/**
+ * @brief Writes an integer conversion, with its sign or prefix, precision
+ * zeros and width padding.
+ *
+ * @param output Output to write to.
+ * @param spec Conversion specification.
+ * @param value Magnitude of the number.
+ * @param negative Whether to write a minus sign.
+ * @param base 8, 10 or 16.
+ */
+static void format_integer(Format_Output* output,
+    const Format_Specification* spec, uintmax_t value, bool negative,
+    unsigned int base);
+
+/**
+ * @brief Writes the digits of a number backwards, ending at end. Decimal
+ * digits are written in pairs from a table, and 64-bit numbers are split
+ * into nine-digit blocks so that most divisions are 32-bit.
+ *
+ * @param value Number to write.
+ * @param base 8, 10 or 16.
+ * @param upper Whether to write uppercase hexadecimal digits.
+ * @param end End of the buffer, which must hold FORMAT_DIGITS_SIZE
+ * characters.
+ *
+ * @return First digit written.
+ */
+static char* format_digits(uintmax_t value, unsigned int base, bool upper,
+    char* end);
+
+/**
+ * @brief Writes a string conversion, padded to the width.
+ *
+ * @param output Output to write to.
+ * @param spec Conversion specification.
+ * @param s Characters to write.
+ * @param length Number of characters to write.
+ */
+static void format_string(Format_Output* output,
+    const Format_Specification* spec, const char* s, size_t length);
+
+/**
+ * @brief Writes characters to an output. Characters that do not fit in a
+ * buffer are counted and dropped.
+ *
+ * @param output Output to write to.
+ * @param data Characters to write.
+ * @param size Number of characters to write.
+ */
+static void format_write(Format_Output* output, const char* data,
+    size_t size);
+
+/**
+ * @brief Writes a character to an output a number of times.
+ *
+ * @param output Output to write to.
+ * @param c Character to write.
+ * @param count Number of times to write it.
+ */
+static void format_pad(Format_Output* output, char c, size_t count);
+
+/**
+ * @brief Converts a count of formatted characters to a return value.
+ *
+ * @param count Number of characters.
+ *
+ * @return count, or -1 if it does not fit in an int.
+ */
+static inline int format_result(size_t count);
+
+/**
+ * @brief Every pair of decimal digits, from "00" to "99".
+ */
+static const char format_digit_pairs[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * @brief Lowercase and uppercase hexadecimal digits.
+ */
+static const char format_hex_digits[2][16] =
+{
+    {
+        '0', '1', '2', '3', '4', '5', '6', '7',
+        '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+    },
+    {
+        '0', '1', '2', '3', '4', '5', '6', '7',
+        '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+    }
+};
+
+/**
+ * @brief Buffer of stdout.
+ */
+static char stdout_buffer[BUFSIZ];
+
+/**
+ * @brief Standard output stream.
+ */
+static FILE stdout_stream =
+{
+    stdout_buffer, BUFSIZ, 0, _IOLBF, terminal_write, 0
+};
+
+/**
+ * @brief Standard error stream. Unbuffered, so that messages appear even
+ * if the kernel stops right after writing them.
+ */
+static FILE stderr_stream =
+{
+    NULL, 0, 0, _IONBF, terminal_write, 0
+};
+
+FILE* stdout = &stdout_stream;
+FILE* stderr = &stderr_stream;
+
+size_t fwrite(const void* ptr, size_t size, size_t nobj, FILE* stream)
+{
+    if ((size == 0) || (nobj == 0))
+    {
+        return (0);
+    }
+
+    uint32_t state = lock_stream(stream);
+
+    /* Writes object by object only if the total would overflow. */
+    if (nobj <= (SIZE_MAX / size))
+    {
+        write_locked(stream, ptr, size * nobj);
+    }
+    else
+    {
+        for (size_t i = 0; i < nobj; ++i)
+        {
+            write_locked(stream, (const char*) ptr + (i * size), size);
+        }
+    }
+
+    unlock_stream(stream, state);
+    return (nobj);
+}
+
+int fputs(const char* s, FILE* stream)
+{
+    size_t size = strlen(s);
+    uint32_t state = lock_stream(stream);
+
+    write_locked(stream, s, size);
+    unlock_stream(stream, state);
+
+    return (0);
+}
+
+int puts(const char* s)
+{
+    size_t size = strlen(s);
+    uint32_t state = lock_stream(stdout);
+
+    /* One lock keeps the line whole. */
+    write_locked(stdout, s, size);
+    write_locked(stdout, "\n", 1);
+    unlock_stream(stdout, state);
+
+    return (0);
+}
+
+int fputc(int c, FILE* stream)
+{
+    char byte = (char) c;
+    uint32_t state = lock_stream(stream);
+
+    write_locked(stream, &byte, 1);
+    unlock_stream(stream, state);
+
+    return ((unsigned char) byte);
+}
+
+int putc(int c, FILE* stream)
+{
+    return (fputc(c, stream));
+}
+
+int putchar(int c)
+{
+    return (fputc(c, stdout));
+}
+
+int fflush(FILE* stream)
+{
+    if (stream == NULL)
+    {
+        fflush(stdout);
+        fflush(stderr);
+        return (0);
+    }
+
+    uint32_t state = lock_stream(stream);
+
+    flush_locked(stream);
+    unlock_stream(stream, state);
+
+    return (0);
+}
+
+int setvbuf(FILE* stream, char* buf, int mode, size_t size)
+{
+    if ((mode != _IOFBF) && (mode != _IOLBF) && (mode != _IONBF))
+    {
+        return (-1);
+    }
+
+    uint32_t state = lock_stream(stream);
+    int ret = 0;
+
+    flush_locked(stream);
+    if (buf != NULL)
+    {
+        stream->buffer = buf;
+        stream->capacity = size;
+    }
+
+    if ((mode != _IONBF) && ((stream->buffer == NULL)
+        || (stream->capacity == 0)))
+    {
+        ret = -1;
+    }
+    else
+    {
+        stream->mode = mode;
+    }
+
+    unlock_stream(stream, state);
+    return (ret);
+}
+
+int printf(const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int ret = vfprintf(stdout, format, args);
+    va_end(args);
+
+    return (ret);
+}
+
+int fprintf(FILE* stream, const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int ret = vfprintf(stream, format, args);
+    va_end(args);
+
+    return (ret);
+}
+
+int vprintf(const char* format, va_list args)
+{
+    return (vfprintf(stdout, format, args));
+}
+
+int vfprintf(FILE* stream, const char* format, va_list args)
+{
+    Format_Output output = {NULL, 0, 0, stream};
+    uint32_t state = lock_stream(stream);
+
+    format_arguments(&output, format, args);
+    unlock_stream(stream, state);
+
+    return (format_result(output.count));
+}
+
+int snprintf(char* s, size_t n, const char* format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int ret = vsnprintf(s, n, format, args);
+    va_end(args);
+
+    return (ret);
+}
+
+int vsnprintf(char* s, size_t n, const char* format, va_list args)
+{
+    Format_Output output = {s, (n > 0) ? n - 1 : 0, 0, NULL};
+
+    format_arguments(&output, format, args);
+    if (n > 0)
+    {
+        s[(output.count < output.capacity) ? output.count
+            : output.capacity] = '\0';
+    }
+
+    return (format_result(output.count));
+}
+
 void write(const char* str, size_t len)
 {
-    char backup_char = str[len];
-    ((char*) str)[len] = 0;
+    uint32_t state = lock_stream(stdout);
+
+    write_locked(stdout, str, len);
+    flush_locked(stdout);
+    unlock_stream(stdout, state);
+}
+
+void write_emergency(const char* str, size_t len)
+{
+    uint32_t state = cpu_save_interrupts();
+
+    /* A held lock may belong to the code that failed, which will never
+     * release it, so the buffered output is only flushed if it is free. */
+    if (spinlock_try_acquire(&stdout->lock))
+    {
+        flush_locked(stdout);
+        spinlock_release(&stdout->lock);
+    }
+
+    terminal_write(str, len);
+    cpu_restore_interrupts(state);
+}
+
+static uint32_t lock_stream(FILE* stream)
+{
+    uint32_t state = cpu_save_interrupts();
+
+    spinlock_acquire(&stream->lock);
+    return (state);
+}
+
+static void unlock_stream(FILE* stream, uint32_t state)
+{
+    spinlock_release(&stream->lock);
+    cpu_restore_interrupts(state);
+}
+
+static void write_locked(FILE* stream, const char* data, size_t size)
+{
+    if (stream->mode == _IONBF)
+    {
+        stream->sink(data, size);
+        return;
+    }
+
+    if (size > stream->capacity - stream->count)
+    {
+        flush_locked(stream);
+
+        /* Data that would fill the buffer on its own skips the copy. */
+        if (size >= stream->capacity)
+        {
+            stream->sink(data, size);
+            return;
+        }
+    }
+
+    memcpy(stream->buffer + stream->count, data, size);
+    stream->count += size;
+
+    if ((stream->mode == _IOLBF) && (memchr(data, '\n', size) != NULL))
+    {
+        flush_locked(stream);
+    }
+}
+
+static void flush_locked(FILE* stream)
+{
+    if (stream->count > 0)
+    {
+        stream->sink(stream->buffer, stream->count);
+        stream->count = 0;
+    }
+}
+
+static void format_arguments(Format_Output* output, const char* format,
+    va_list args)
+{
+    /* A copy can be passed by address on every ABI, whatever va_list is. */
+    va_list ap;
+
+    va_copy(ap, args);
+
+    const char* p = format;
+
+    for (;;)
+    {
+        /* Text between conversions is written in one piece. */
+        const char* literal = p;
+
+        while ((*p != '\0') && (*p != '%'))
+        {
+            ++p;
+        }
+        if (p != literal)
+        {
+            format_write(output, literal, (size_t) (p - literal));
+        }
+        if (*p == '\0')
+        {
+            break;
+        }
+
+        const char* conversion = p++;
+        Format_Specification spec = {0, 0, -1};
+
+        for (bool flag = true; flag; )
+        {
+            switch (*p)
+            {
+            case ('-'):
+                spec.flags |= FORMAT_LEFT;
+                ++p;
+                break;
+
+            case ('+'):
+                spec.flags |= FORMAT_PLUS;
+                ++p;
+                break;
+
+            case (' '):
+                spec.flags |= FORMAT_SPACE;
+                ++p;
+                break;
+
+            case ('#'):
+                spec.flags |= FORMAT_ALTERNATE;
+                ++p;
+                break;
+
+            case ('0'):
+                spec.flags |= FORMAT_ZERO;
+                ++p;
+                break;
+
+            default:
+                flag = false;
+                break;
+            }
+        }
+
+        if (*p == '*')
+        {
+            int width = va_arg(ap, int);
+
+            /* A negative width is a '-' flag and a positive width. */
+            if (width < 0)
+            {
+                spec.flags |= FORMAT_LEFT;
+                spec.width = 0U - (unsigned int) width;
+            }
+            else
+            {
+                spec.width = (size_t) width;
+            }
+            ++p;
+        }
+        else
+        {
+            while ((*p >= '0') && (*p <= '9'))
+            {
+                spec.width = (spec.width * 10) + (size_t) (*p++ - '0');
+            }
+        }
+
+        if (*p == '.')
+        {
+            ++p;
+            if (*p == '*')
+            {
+                /* A negative precision counts as none. */
+                spec.precision = va_arg(ap, int);
+                ++p;
+            }
+            else
+            {
+                spec.precision = 0;
+                while ((*p >= '0') && (*p <= '9'))
+                {
+                    spec.precision = (spec.precision * 10) + (*p++ - '0');
+                }
+            }
+        }
+
+        Format_Length length = FORMAT_LENGTH_INT;
+
+        switch (*p)
+        {
+        case ('h'):
+            ++p;
+            length = FORMAT_LENGTH_SHORT;
+            if (*p == 'h')
+            {
+                ++p;
+                length = FORMAT_LENGTH_CHAR;
+            }
+            break;
+
+        case ('l'):
+            ++p;
+            length = FORMAT_LENGTH_LONG;
+            if (*p == 'l')
+            {
+                ++p;
+                length = FORMAT_LENGTH_LONG_LONG;
+            }
+            break;
+
+        case ('j'):
+            ++p;
+            length = FORMAT_LENGTH_INTMAX;
+            break;
+
+        case ('z'):
+            ++p;
+            length = FORMAT_LENGTH_SIZE;
+            break;
+
+        case ('t'):
+            ++p;
+            length = FORMAT_LENGTH_PTRDIFF;
+            break;
+
+        default:
+            break;
+        }
+
+        switch (*p)
+        {
+        case ('d'):
+        case ('i'):
+        {
+            intmax_t value = format_read_signed(&ap, length);
+
+            format_integer(output, &spec,
+                (value < 0) ? 0U - (uintmax_t) value : (uintmax_t) value,
+                value < 0, 10);
+            break;
+        }
+
+        case ('u'):
+        case ('o'):
+        case ('x'):
+        case ('X'):
+        {
+            /* Signs only belong to signed conversions. */
+            spec.flags &= ~(unsigned int) (FORMAT_PLUS | FORMAT_SPACE);
+            if (*p == 'X')
+            {
+                spec.flags |= FORMAT_UPPER;
+            }
 
-    terminal_write_string(str);
+            format_integer(output, &spec, format_read_unsigned(&ap, length),
+                false, (*p == 'u') ? 10 : ((*p == 'o') ? 8 : 16));
+            break;
+        }
 
-    ((char*) str)[len] = backup_char;
+        case ('p'):
+        {
+            spec.flags &= ~(unsigned int) (FORMAT_PLUS | FORMAT_SPACE);
+            spec.flags |= FORMAT_ALTERNATE | FORMAT_POINTER;
+
+            format_integer(output, &spec,
+                (uintptr_t) va_arg(ap, void*), false, 16);
+            break;
+        }
+
+        case ('c'):
+        {
+            char c = (char) va_arg(ap, int);
+
+            format_string(output, &spec, &c, 1);
+            break;
+        }
+
+        case ('s'):
+        {
+            const char* s = va_arg(ap, const char*);
+
+            if (s == NULL)
+            {
+                s = "(null)";
+            }
+
+            /* With a precision, s need not be null-terminated. */
+            size_t size;
+
+            if (spec.precision >= 0)
+            {
+                const char* end = memchr(s, '\0', (size_t) spec.precision);
+
+                size = (end != NULL) ? (size_t) (end - s)
+                    : (size_t) spec.precision;
+            }
+            else
+            {
+                size = strlen(s);
+            }
+
+            format_string(output, &spec, s, size);
+            break;
+        }
+
+        case ('%'):
+            format_write(output, "%", 1);
+            break;
+
+        case ('\0'):
+            /* A lone '%' at the end is written as it is. */
+            format_write(output, conversion, (size_t) (p - conversion));
+            va_end(ap);
+            return;
+
+        default:
+            /* Unknown conversions are written as they are. */
+            format_write(output, conversion, (size_t) (p + 1 - conversion));
+            break;
+        }
+
+        ++p;
+    }
+
+    va_end(ap);
+}
+
+static intmax_t format_read_signed(va_list* args, Format_Length length)
+{
+    switch (length)
+    {
+    case (FORMAT_LENGTH_CHAR):
+        return ((signed char) va_arg(*args, int));
+
+    case (FORMAT_LENGTH_SHORT):
+        return ((short) va_arg(*args, int));
+
+    case (FORMAT_LENGTH_LONG):
+        return (va_arg(*args, long));
+
+    case (FORMAT_LENGTH_LONG_LONG):
+        return (va_arg(*args, long long));
+
+    case (FORMAT_LENGTH_INTMAX):
+        return (va_arg(*args, intmax_t));
+
+    case (FORMAT_LENGTH_SIZE):
+        /* There is no signed size_t type; ptrdiff_t has the same width. */
+        return (va_arg(*args, ptrdiff_t));
+
+    case (FORMAT_LENGTH_PTRDIFF):
+        return (va_arg(*args, ptrdiff_t));
+
+    default:
+        return (va_arg(*args, int));
+    }
+}
+
+static uintmax_t format_read_unsigned(va_list* args, Format_Length length)
+{
+    switch (length)
+    {
+    case (FORMAT_LENGTH_CHAR):
+        return ((unsigned char) va_arg(*args, unsigned int));
+
+    case (FORMAT_LENGTH_SHORT):
+        return ((unsigned short) va_arg(*args, unsigned int));
+
+    case (FORMAT_LENGTH_LONG):
+        return (va_arg(*args, unsigned long));
+
+    case (FORMAT_LENGTH_LONG_LONG):
+        return (va_arg(*args, unsigned long long));
+
+    case (FORMAT_LENGTH_INTMAX):
+        return (va_arg(*args, uintmax_t));
+
+    case (FORMAT_LENGTH_SIZE):
+        return (va_arg(*args, size_t));
+
+    case (FORMAT_LENGTH_PTRDIFF):
+        return ((uintmax_t) va_arg(*args, ptrdiff_t));
+
+    default:
+        return (va_arg(*args, unsigned int));
+    }
+}
+
+static void format_integer(Format_Output* output,
+    const Format_Specification* spec, uintmax_t value, bool negative,
+    unsigned int base)
+{
+    char digits[FORMAT_DIGITS_SIZE];
+    char* end = digits + FORMAT_DIGITS_SIZE;
+    char* start = end;
+
+    /* A precision of zero writes no digits for zero. */
+    if ((value != 0) || (spec->precision != 0))
+    {
+        start = format_digits(value, base, (spec->flags & FORMAT_UPPER) != 0,
+            end);
+    }
+
+    size_t length = (size_t) (end - start);
+    char prefix[2];
+    size_t prefix_length = 0;
+
+    if (negative)
+    {
+        prefix[prefix_length++] = '-';
+    }
+    else if (spec->flags & FORMAT_PLUS)
+    {
+        prefix[prefix_length++] = '+';
+    }
+    else if (spec->flags & FORMAT_SPACE)
+    {
+        prefix[prefix_length++] = ' ';
+    }
+
+    if ((base == 16) && (spec->flags & FORMAT_ALTERNATE)
+        && ((value != 0) || (spec->flags & FORMAT_POINTER)))
+    {
+        prefix[prefix_length++] = '0';
+        prefix[prefix_length++] = (spec->flags & FORMAT_UPPER) ? 'X' : 'x';
+    }
+
+    size_t zeros = 0;
+
+    if ((spec->precision > 0) && ((size_t) spec->precision > length))
+    {
+        zeros = (size_t) spec->precision - length;
+    }
+
+    /* The octal prefix is a leading zero, which a precision may supply. */
+    if ((base == 8) && (spec->flags & FORMAT_ALTERNATE) && (zeros == 0)
+        && ((length == 0) || (*start != '0')))
+    {
+        zeros = 1;
+    }
+
+    size_t size = prefix_length + zeros + length;
+    size_t padding = (spec->width > size) ? spec->width - size : 0;
+
+    /* The '0' flag is ignored with '-' or a precision. */
+    if ((spec->flags & FORMAT_ZERO) && !(spec->flags & FORMAT_LEFT)
+        && (spec->precision < 0))
+    {
+        zeros += padding;
+        padding = 0;
+    }
+
+    if (!(spec->flags & FORMAT_LEFT))
+    {
+        format_pad(output, ' ', padding);
+    }
+
+    format_write(output, prefix, prefix_length);
+    format_pad(output, '0', zeros);
+    format_write(output, start, length);
+
+    if (spec->flags & FORMAT_LEFT)
+    {
+        format_pad(output, ' ', padding);
+    }
+}
+
+static char* format_digits(uintmax_t value, unsigned int base, bool upper,
+    char* end)
+{
+    if (base != 10)
+    {
+        const char* digits = format_hex_digits[upper];
+        unsigned int shift = (base == 16) ? 4 : 3;
+        unsigned int mask = base - 1;
+
+        do
+        {
+            *--end = digits[value & mask];
+            value >>= shift;
+        } while (value != 0);
+
+        return (end);
+    }
+
+    /* Only the blocks above 32 bits need 64-bit division. */
+    while (value > UINT32_MAX)
+    {
+        uint32_t block = (uint32_t) (value % 1000000000);
+
+        value /= 1000000000;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            const char* pair = &format_digit_pairs[(block % 100) * 2];
+
+            block /= 100;
+            end -= 2;
+            end[0] = pair[0];
+            end[1] = pair[1];
+        }
+        *--end = (char) ('0' + block);
+    }
+
+    uint32_t rest = (uint32_t) value;
+
+    while (rest >= 100)
+    {
+        const char* pair = &format_digit_pairs[(rest % 100) * 2];
+
+        rest /= 100;
+        end -= 2;
+        end[0] = pair[0];
+        end[1] = pair[1];
+    }
+
+    if (rest >= 10)
+    {
+        end -= 2;
+        end[0] = format_digit_pairs[rest * 2];
+        end[1] = format_digit_pairs[(rest * 2) + 1];
+    }
+    else
+    {
+        *--end = (char) ('0' + rest);
+    }
+
+    return (end);
+}
+
+static void format_string(Format_Output* output,
+    const Format_Specification* spec, const char* s, size_t length)
+{
+    size_t padding = (spec->width > length) ? spec->width - length : 0;
+
+    if (!(spec->flags & FORMAT_LEFT))
+    {
+        format_pad(output, ' ', padding);
+    }
+
+    format_write(output, s, length);
+
+    if (spec->flags & FORMAT_LEFT)
+    {
+        format_pad(output, ' ', padding);
+    }
+}
+
+static void format_write(Format_Output* output, const char* data,
+    size_t size)
+{
+    if (output->stream != NULL)
+    {
+        write_locked(output->stream, data, size);
+    }
+    else if (output->count < output->capacity)
+    {
+        size_t room = output->capacity - output->count;
+
+        memcpy(output->buffer + output->count, data,
+            (size < room) ? size : room);
+    }
+
+    output->count += size;
+}
+
+static void format_pad(Format_Output* output, char c, size_t count)
+{
+    char pad[FORMAT_PAD_SIZE];
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    memset(pad, c, (count < FORMAT_PAD_SIZE) ? count : FORMAT_PAD_SIZE);
+    while (count > FORMAT_PAD_SIZE)
+    {
+        format_write(output, pad, FORMAT_PAD_SIZE);
+        count -= FORMAT_PAD_SIZE;
+    }
+    format_write(output, pad, count);
+}
+
+static inline int format_result(size_t count)
+{
+    return ((count > INT_MAX) ? -1 : (int) count);
 }
@@ -25,30 +25,263 @@
 
 #include <string.h>
 
+#include <boot/kernel/simd/simd.h>
+
+/**
+ * @brief Size below which memory functions work one byte at a time, since
+ * aligning for word accesses would cost more than it saves.
+ */
+#define STRING_WORD_THRESHOLD 16
+
+/**
+ * @brief Size from which memory functions use rep movsl and rep stosl,
+ * whose startup cost is only repaid by long runs.
+ */
+#define STRING_REP_THRESHOLD 512
+
+/**
+ * @brief Word with every byte set to 1, for finding bytes a word at a time.
+ */
+#define STRING_ONES 0x01010101U
+
+/**
+ * @brief Word with the high bit of every byte set.
+ */
+#define STRING_HIGHS 0x80808080U
+
+/**
+ * @brief Set of characters, with one bit for each unsigned char value.
+ */
+typedef struct Character_Set
+{
+    uint32_t bits[256 / 32];
+} Character_Set;
+
+/**
+ * @brief Word that may be unaligned and may alias any object, for word at a
+ * time memory functions.
+ */
+typedef uint32_t __attribute__((may_alias, aligned(1))) Word;
+
+/**
+ * @brief Copies memory from lower addresses to higher ones, a word at a
+ * time once the destination is aligned.
+ *
+ * @param s Destination.
+ * @param ct Source. May overlap s only if it lies above s.
+ * @param n Number of bytes to copy.
+ */
+static void copy_forward(void* s, const void* ct, size_t n);
+
+/**
+ * @brief Copies memory from higher addresses to lower ones, a word at a
+ * time once the end of the destination is aligned.
+ *
+ * @param s Destination.
+ * @param ct Source. May overlap s only if it lies below s.
+ * @param n Number of bytes to copy.
+ */
+static void copy_backward(void* s, const void* ct, size_t n);
+
+/**
+ * @brief Finds a needle of 2 to 4 bytes by sliding a window of the last
+ * bytes of the haystack, packed into a word, over it.
+ *
+ * @param cs Haystack.
+ * @param n Size of the haystack.
+ * @param ct Needle.
+ * @param m Size of the needle, from 2 to 4.
+ *
+ * @return Pointer to the first match, or NULL if there is none.
+ */
+static void* search_packed(
+    const uint8_t* cs,
+    size_t n,
+    const uint8_t* ct,
+    size_t m);
+
+/**
+ * @brief Finds a needle with the Crochemore-Perrin Two-Way algorithm, which
+ * runs in linear time and constant space.
+ *
+ * @param cs Haystack.
+ * @param n Size of the haystack.
+ * @param ct Needle.
+ * @param m Size of the needle, at most n.
+ *
+ * @return Pointer to the first match, or NULL if there is none.
+ */
+static void* search_two_way(
+    const uint8_t* cs,
+    size_t n,
+    const uint8_t* ct,
+    size_t m);
+
+/**
+ * @brief Finds the maximal suffix of a needle under an ordering of bytes,
+ * which gives one candidate for its critical factorization.
+ *
+ * @param ct Needle.
+ * @param m Size of the needle.
+ * @param reversed Whether bytes are ordered from greatest to least.
+ * @param period Location to store the period of the suffix in.
+ *
+ * @return Position at which the suffix starts.
+ */
+static size_t find_maximal_suffix(
+    const uint8_t* ct,
+    size_t m,
+    bool reversed,
+    size_t* period);
+
+/**
+ * @brief Builds the set of characters in a string, plus the terminator, so
+ * that scans for members of the set stop at the end of the string without
+ * testing for it separately.
+ *
+ * @param set Set to build.
+ * @param ct Characters to put in the set.
+ */
+static inline void build_set(Character_Set* set, const char* ct);
+
+/**
+ * @brief Checks whether a character is in a set.
+ *
+ * @param set Set to check.
+ * @param c Character to look for.
+ *
+ * @return True if c is in the set.
+ */
+static inline bool is_in_set(const Character_Set* set, char c);
+
+/**
+ * @brief Counts the characters at the start of a string that are in a set.
+ *
+ * @param cs String to scan.
+ * @param set Set from build_set.
+ *
+ * @return Number of characters before the first one not in the set, or
+ * before the terminator.
+ */
+static inline size_t count_accepted(const char* cs, const Character_Set* set);
+
+/**
+ * @brief Counts the characters at the start of a string that are not in a
+ * set.
+ *
+ * @param cs String to scan.
+ * @param set Set from build_set.
+ *
+ * @return Number of characters before the first one in the set, or before
+ * the terminator.
+ */
+static inline size_t count_rejected(const char* cs, const Character_Set* set);
+
+/**
+ * @brief Finds the zero bytes of a word. The lowest set bit is exact; bits
+ * above a zero byte may be set spuriously.
+ *
+ * @param word Word to test.
+ *
+ * @return Word with the high bit of the lowest zero byte set, or 0 if there
+ * is none.
+ */
+static inline uint32_t find_zero(uint32_t word);
+
+/**
+ * @brief Gets the index of the byte marked by the lowest bit of a mask.
+ *
+ * @param mask Nonzero mask from find_zero.
+ *
+ * @return Index of the byte, counted from the lowest address.
+ */
+static inline size_t get_byte_index(uint32_t mask);
+
 void* memchr(const void* cs, int c, size_t n)
 {
-    for (size_t i = 0; i < n; ++i)
+    if (n >= SIMD_MINIMUM_SIZE)
     {
-        if ((((uint8_t*) cs)[i]) == ((uint8_t) c))
+        const Simd_Functions* simd = simd_begin();
+
+        if (simd != NULL)
         {
-            return ((void*) &(((uint8_t*) cs)[i]));
+            void* ret = simd->find(cs, (uint8_t) c, n);
+
+            simd_end();
+            return (ret);
         }
     }
+
+    const uint8_t* cs1 = (const uint8_t*) cs;
+    uint8_t c1 = (uint8_t) c;
+
+    while (n != 0 && ((uintptr_t) cs1 & (sizeof(uint32_t) - 1)) != 0)
+    {
+        if (*cs1 == c1)
+        {
+            return ((void*) cs1);
+        }
+        ++cs1;
+        --n;
+    }
+
+    /* Bytes equal to c become zero bytes. */
+    uint32_t pattern = c1 * STRING_ONES;
+
+    for (; n >= sizeof(uint32_t); n -= sizeof(uint32_t))
+    {
+        uint32_t mask = find_zero(*((const Word*) cs1) ^ pattern);
+
+        if (mask != 0)
+        {
+            return ((void*) (cs1 + get_byte_index(mask)));
+        }
+        cs1 += sizeof(uint32_t);
+    }
+
+    for (; n != 0; --n)
+    {
+        if (*cs1 == c1)
+        {
+            return ((void*) cs1);
+        }
+        ++cs1;
+    }
     return (NULL);
 }
 
 int memcmp(const void* cs, const void* ct, size_t n)
 {
-    for (size_t i = 0; i < n; ++i)
+    if (n >= SIMD_MINIMUM_SIZE)
     {
-        if ((((unsigned char*) cs)[i]) > (((unsigned char*) ct)[i]))
+        const Simd_Functions* simd = simd_begin();
+
+        if (simd != NULL)
         {
-            return (1);
+            int ret = simd->compare(cs, ct, n);
+
+            simd_end();
+            return (ret);
         }
+    }
 
-        if ((((unsigned char*) cs)[i]) < (((unsigned char*) ct)[i]))
+    const uint8_t* cs1 = (const uint8_t*) cs;
+    const uint8_t* ct1 = (const uint8_t*) ct;
+    size_t i = 0;
+
+    /* Skips the equal words; the first differing byte is then found in the
+     * word that differs, or among the bytes after the last whole word. */
+    while (i + sizeof(uint32_t) <= n
+        && *((const Word*) (cs1 + i)) == *((const Word*) (ct1 + i)))
+    {
+        i += sizeof(uint32_t);
+    }
+
+    for (; i < n; ++i)
+    {
+        if (cs1[i] != ct1[i])
         {
-            return (-1);
+            return ((cs1[i] > ct1[i]) ? 1 : -1);
         }
     }
 
@@ -64,13 +297,47 @@ void* memcpy(void* s, const void* ct, size_t n)
         return (s);
     }
 
-    for (size_t i = 0; i < n; ++i)
+    if (n >= SIMD_MINIMUM_SIZE)
     {
-        ((uint8_t*) s)[i] = ((uint8_t*) ct)[i];
+        const Simd_Functions* simd = simd_begin();
+
+        if (simd != NULL)
+        {
+            simd->copy(s, ct, n);
+            simd_end();
+            return (s);
+        }
     }
+
+    copy_forward(s, ct, n);
     return (s);
 }
 
+void* memmem(const void* cs, size_t n, const void* ct, size_t m)
+{
+    const uint8_t* cs1 = (const uint8_t*) cs;
+    const uint8_t* ct1 = (const uint8_t*) ct;
+
+    if (m == 0)
+    {
+        return ((void*) cs);
+    }
+    if (m > n)
+    {
+        return (NULL);
+    }
+    if (m == 1)
+    {
+        return (memchr(cs, ct1[0], n));
+    }
+    if (m <= sizeof(uint32_t))
+    {
+        return (search_packed(cs1, n, ct1, m));
+    }
+
+    return (search_two_way(cs1, n, ct1, m));
+}
+
 void* memmove(void* s, const void* ct, size_t n)
 {
     /* If locations are the same, there is no reason to copy anything. */
@@ -79,61 +346,130 @@ void* memmove(void* s, const void* ct, size_t n)
         return (s);
     }
 
-    /* If s is lower in memory than ct, then copy memory backwards. */
-    if (s < ct)
+    /* If s is higher in memory than ct and the objects overlap, copying
+     * forwards would overwrite ct before it is read, so copy backwards. */
+    if (((uintptr_t) s - (uintptr_t) ct) < n)
+    {
+        copy_backward(s, ct, n);
+    }
+    /* Otherwise, copying forwards only overwrites what was already read. */
+    else
+    {
+        copy_forward(s, ct, n);
+    }
+    return (s);
+}
+
+void* memset(void* s, int c, size_t n)
+{
+    uint8_t* s1 = (uint8_t*) s;
+    uint8_t c1 = (uint8_t) c;
+
+    if (n >= SIMD_MINIMUM_SIZE)
+    {
+        const Simd_Functions* simd = simd_begin();
+
+        if (simd != NULL)
+        {
+            simd->fill(s, c1, n);
+            simd_end();
+            return (s);
+        }
+    }
+
+    if (n < STRING_WORD_THRESHOLD)
     {
         for (size_t i = 0; i < n; ++i)
         {
-            ((uint8_t*) s)[n - 1 - i] = ((uint8_t*) s)[n - 1 - i];
+            s1[i] = c1;
         }
         return (s);
     }
-    /* If s is higher in memory than ct, then copy memory forwards. */
+
+    /* Aligns the destination, so that no word store splits a cache line. */
+    while (((uintptr_t) s1 & (sizeof(uint32_t) - 1)) != 0)
+    {
+        *s1++ = c1;
+        --n;
+    }
+
+    uint32_t word = c1 * 0x01010101U;
+    size_t words = n / sizeof(uint32_t);
+
+    if (n >= STRING_REP_THRESHOLD)
+    {
+        asm volatile
+        (
+            "rep stosl\n"
+            : "+D" (s1), "+c" (words)
+            : "a" (word)
+            : "memory"
+        );
+    }
     else
     {
-        for (size_t i = 0; i < n; ++i)
+        for (; words != 0; --words)
         {
-            ((uint8_t*) s)[i] = ((uint8_t*) ct)[i];
+            *((Word*) s1) = word;
+            s1 += sizeof(uint32_t);
         }
-        return (s);
     }
-}
 
-void* memset(void* s, int c, size_t n)
-{
-    unsigned char* s1 = (unsigned char*) s;
-    unsigned char c1 = (unsigned char) c;
-    for (size_t i = 0; i < n; ++i)
+    for (n &= sizeof(uint32_t) - 1; n != 0; --n)
     {
-        s1[i] = c1;
+        *s1++ = c1;
     }
-    return (s1);
+    return (s);
 }
 
-char* strcat(char* s, const char* ct)
+char* stpcpy(char* s, const char* ct)
 {
-    size_t s_length = strlen(s);
     size_t ct_length = strlen(ct);
 
-    for (size_t i = 0; ct[i] != '\0'; ++i)
-    {
-        s[s_length + i] = ct[i];
-    }
-    s[s_length + ct_length] = '\0';
+    memcpy(s, ct, ct_length + 1);
+    return (s + ct_length);
+}
 
+char* strcat(char* s, const char* ct)
+{
+    stpcpy(s + strlen(s), ct);
     return (s);
 }
 
 char* strchr(const char* cs, int c)
 {
-    for (size_t i = 0; cs[i] != '\0'; ++i)
+    char c1 = (char) c;
+
+    while (((uintptr_t) cs & (sizeof(uint32_t) - 1)) != 0)
     {
-        if (cs[i] == ((char) c))
+        if (*cs == c1)
         {
-            return (&cs[i]);
+            return ((char*) cs);
+        }
+        if (*cs == '\0')
+        {
+            return (NULL);
+        }
+        ++cs;
+    }
+
+    uint32_t pattern = (uint8_t) c1 * STRING_ONES;
+
+    /* Aligned words never cross into a page the string does not use, so
+     * reading past the terminator is safe. */
+    for (;; cs += sizeof(uint32_t))
+    {
+        uint32_t word = *((const Word*) cs);
+        uint32_t mask = find_zero(word) | find_zero(word ^ pattern);
+
+        if (mask != 0)
+        {
+            cs += get_byte_index(mask);
+
+            /* The terminator counts as part of the string. */
+            return ((*cs == c1) ? (char*) cs : NULL);
         }
     }
-    return (NULL);
 }
 
 int strcmp(const char* cs, const char* ct)
@@ -166,34 +502,16 @@ int strcmp(const char* cs, const char* ct)
 
 char* strcpy(char* s, const char* ct)
 {
-    size_t ct_length = strlen(ct);
-
-    for (size_t i = 0; i < ct_length; ++i)
-    {
-        s[i] = ct[i];
-    }
-    s[ct_length] = '\0';
-
+    memcpy(s, ct, strlen(ct) + 1);
     return (s);
 }
 
 size_t strcspn(const char* cs, const char* ct)
 {
-    size_t length = 0;
-
-    for (size_t i = 0; cs[i] != '\0'; ++i)
-    {
-        if (strchr(ct, cs[i]) == NULL)
-        {
-            ++length;
-        }
-        else
-        {
-            return (length);
-        }
-    }
+    Character_Set set;
 
-    return (length);
+    build_set(&set, ct);
+    return (count_rejected(cs, &set));
 }
 
 char* strerror(int n)
@@ -201,64 +519,95 @@ char* strerror(int n)
 
 }
 
-size_t strlen(const char* cs)
+size_t strlcat(char* s, const char* ct, size_t n)
 {
-    size_t ret = 0;
-    for (size_t i = 0; cs[i] != '\0'; ++i)
+    /* s is only searched as far as n, so it need not be terminated. */
+    const char* end = memchr(s, '\0', n);
+
+    if (end == NULL)
     {
-        ++ret;
+        return (n + strlen(ct));
     }
-    return (ret);
+
+    size_t s_length = (size_t) (end - s);
+
+    return (s_length + strlcpy(s + s_length, ct, n - s_length));
 }
 
-char* strncat(char* s, const char* ct, size_t n)
+size_t strlcpy(char* s, const char* ct, size_t n)
 {
-    size_t s_length = strlen(s);
     size_t ct_length = strlen(ct);
 
-    for (size_t i = 0; (i < ct_length) && (i < n); ++i)
+    if (n > 0)
     {
-        s[s_length + i] = ct[i];
-    }
+        size_t copy = (ct_length < n) ? ct_length : n - 1;
 
-    for (size_t i = ct_length; i < n; ++i)
-    {
-        s[s_length + i] = '\0';
+        memcpy(s, ct, copy);
+        s[copy] = '\0';
     }
 
-    return (s);
+    return (ct_length);
 }
 
-char* strpbrk(const char* cs, const char* ct)
+size_t strlen(const char* cs)
 {
-    char* str_end = &cs[strlen(cs)];
-    char* ret = str_end;
+    const Simd_Functions* simd = simd_begin();
 
-    for (size_t i = 0; cs[i] != '\0'; ++i)
+    if (simd != NULL)
     {
-        for (size_t i1 = 0; ct[i1] != '\0'; ++i1)
-        {
-            char* first = strchr(cs, ct[i1]);
+        size_t ret = simd->length(cs);
 
-            /* If first is closer to the beginning that any others
-             * so far. */
-            if ((first < ret) && (first != NULL))
-            {
-                ret = first;
-            }
-        }
+        simd_end();
+        return (ret);
     }
 
-    if (ret != str_end)
+    const char* end = cs;
+
+    while (((uintptr_t) end & (sizeof(uint32_t) - 1)) != 0)
     {
-        return (ret);
+        if (*end == '\0')
+        {
+            return ((size_t) (end - cs));
+        }
+        ++end;
     }
-    else
+
+    /* See strchr. */
+    for (;; end += sizeof(uint32_t))
     {
-        return (NULL);
+        uint32_t mask = find_zero(*((const Word*) end));
+
+        if (mask != 0)
+        {
+            return ((size_t) (end - cs) + get_byte_index(mask));
+        }
     }
 }
 
+char* strncat(char* s, const char* ct, size_t n)
+{
+    char* end = s + strlen(s);
+
+    /* ct is only searched as far as n, so it need not be terminated. */
+    const char* ct_end = memchr(ct, '\0', n);
+    size_t ct_length = (ct_end != NULL) ? (size_t) (ct_end - ct) : n;
+
+    memcpy(end, ct, ct_length);
+    end[ct_length] = '\0';
+
+    return (s);
+}
+
+char* strpbrk(const char* cs, const char* ct)
+{
+    Character_Set set;
+
+    build_set(&set, ct);
+    cs += count_rejected(cs, &set);
+
+    return ((*cs != '\0') ? (char*) cs : NULL);
+}
+
 char* strrchr(const char* cs, int c)
 {
     for (size_t i = strlen(cs); i >= 0; --i)
@@ -299,86 +648,404 @@ char* strrev(char* s, const char* ct)
 
 size_t strspn(const char* cs, const char* ct)
 {
-    size_t length = 0;
+    Character_Set set;
+
+    build_set(&set, ct);
+    return (count_accepted(cs, &set));
+}
+
+char* strstr(const char* cs, const char* ct)
+{
+    if (ct[0] == '\0')
+    {
+        return ((char*) cs);
+    }
+
+    /* Skips to the first possible match before measuring the rest. */
+    cs = strchr(cs, ct[0]);
+
+    if (cs == NULL || ct[1] == '\0')
+    {
+        return ((char*) cs);
+    }
+
+    return (memmem(cs, strlen(cs), ct, strlen(ct)));
+}
+
+char* strtok(char* s, const char* ct)
+{
+    /* Points to the rest of the string, after the last token. */
+    static char* next = NULL;
 
-    for (size_t i = 0; cs[i] != '\0'; ++i)
+    /* If continuing from previous token. */
+    if (s == NULL)
     {
-        if (strchr(ct, cs[i]) != NULL)
+        s = next;
+
+        if (s == NULL)
         {
-            ++length;
+            return (NULL);
         }
-        else
+    }
+
+    Character_Set set;
+
+    build_set(&set, ct);
+
+    /* Delimiters before the token are skipped. */
+    s += count_accepted(s, &set);
+
+    /* If there are no more tokens. */
+    if (*s == '\0')
+    {
+        next = NULL;
+        return (NULL);
+    }
+
+    char* token_end = s + count_rejected(s, &set);
+
+    /* If the token ends the string. */
+    if (*token_end == '\0')
+    {
+        next = NULL;
+    }
+    else
+    {
+        *token_end = '\0';
+        next = token_end + 1;
+    }
+
+    return (s);
+}
+
+static void copy_forward(void* s, const void* ct, size_t n)
+{
+    uint8_t* s1 = (uint8_t*) s;
+    const uint8_t* ct1 = (const uint8_t*) ct;
+
+    if (n < STRING_WORD_THRESHOLD)
+    {
+        for (size_t i = 0; i < n; ++i)
         {
-            return (length);
+            s1[i] = ct1[i];
         }
+        return;
+    }
+
+    /* Aligns the destination; unaligned loads are cheaper than unaligned
+     * stores. */
+    while (((uintptr_t) s1 & (sizeof(uint32_t) - 1)) != 0)
+    {
+        *s1++ = *ct1++;
+        --n;
     }
 
-    return (length);
+    size_t words = n / sizeof(uint32_t);
+
+    if (n >= STRING_REP_THRESHOLD)
+    {
+        /* The direction flag is clear, as the System V ABI requires. */
+        asm volatile
+        (
+            "rep movsl\n"
+            : "+D" (s1), "+S" (ct1), "+c" (words)
+            : /* No inputs. */
+            : "memory"
+        );
+    }
+    else
+    {
+        for (; words != 0; --words)
+        {
+            *((Word*) s1) = *((const Word*) ct1);
+            s1 += sizeof(uint32_t);
+            ct1 += sizeof(uint32_t);
+        }
+    }
+
+    for (n &= sizeof(uint32_t) - 1; n != 0; --n)
+    {
+        *s1++ = *ct1++;
+    }
 }
 
-char* strstr(const char* cs, const char* ct)
+static void copy_backward(void* s, const void* ct, size_t n)
 {
-	char* ret;
+    uint8_t* s1 = (uint8_t*) s + n;
+    const uint8_t* ct1 = (const uint8_t*) ct + n;
+
+    if (n < STRING_WORD_THRESHOLD)
+    {
+        while (n-- != 0)
+        {
+            *--s1 = *--ct1;
+        }
+        return;
+    }
 
-	ret = strchr(cs, ct[0]);
-	while (ret != NULL)
-	{
-		for (size_t i = 0; (ret[i] == ct[i]) || (ct[i] == '\0'); ++i)
-		{
-			if (ct[i] == '\0')
-			{
-				return (ret);
-			}
-		}
+    while (((uintptr_t) s1 & (sizeof(uint32_t) - 1)) != 0)
+    {
+        *--s1 = *--ct1;
+        --n;
+    }
 
-		ret = strchr(ret, ct[0]);
-	}
+    /* Backward rep movsl is not accelerated by most processors, so a word
+     * loop is used at every size. */
+    for (size_t words = n / sizeof(uint32_t); words != 0; --words)
+    {
+        s1 -= sizeof(uint32_t);
+        ct1 -= sizeof(uint32_t);
+        *((Word*) s1) = *((const Word*) ct1);
+    }
 
-	return (ret);
+    for (n &= sizeof(uint32_t) - 1; n != 0; --n)
+    {
+        *--s1 = *--ct1;
+    }
 }
 
-char* strtok(char* s, const char* ct)
+static inline uint32_t find_zero(uint32_t word)
+{
+    return ((word - STRING_ONES) & ~word & STRING_HIGHS);
+}
+
+static inline size_t get_byte_index(uint32_t mask)
 {
-    /* Points to next token. */
-    static char* _strtok_next = NULL;
+    return ((size_t) __builtin_ctz(mask) / 8);
+}
 
-    /* If continuing from previous token. */
-    if (s == NULL)
+static inline void build_set(Character_Set* set, const char* ct)
+{
+    for (size_t i = 0; i < sizeof(set->bits) / sizeof(set->bits[0]); ++i)
     {
-        char* current_token = _strtok_next;
-        char* token_end = strpbrk(current_token, ct);
+        set->bits[i] = 0;
+    }
+
+    set->bits[0] = 1;
+
+    for (; *ct != '\0'; ++ct)
+    {
+        uint8_t c = (uint8_t) *ct;
+
+        set->bits[c / 32] |= (uint32_t) 1 << (c % 32);
+    }
+}
 
-        /* If there are no more tokens. */
-        if (token_end == NULL)
+static inline bool is_in_set(const Character_Set* set, char c)
+{
+    uint8_t c1 = (uint8_t) c;
+
+    return ((set->bits[c1 / 32] & ((uint32_t) 1 << (c1 % 32))) != 0);
+}
+
+static inline size_t count_accepted(const char* cs, const Character_Set* set)
+{
+    size_t i = 0;
+
+    while (cs[i] != '\0' && is_in_set(set, cs[i]))
+    {
+        ++i;
+    }
+
+    return (i);
+}
+
+static inline size_t count_rejected(const char* cs, const Character_Set* set)
+{
+    size_t i = 0;
+
+    while (!is_in_set(set, cs[i]))
+    {
+        ++i;
+    }
+
+    return (i);
+}
+
+static void* search_packed(
+    const uint8_t* cs,
+    size_t n,
+    const uint8_t* ct,
+    size_t m)
+{
+    uint32_t mask = (m == sizeof(uint32_t))
+        ? UINT32_MAX : ((uint32_t) 1 << (m * 8)) - 1;
+    uint32_t needle = 0;
+    uint32_t window = 0;
+
+    for (size_t i = 0; i < m; ++i)
+    {
+        needle = (needle << 8) | ct[i];
+        window = (window << 8) | cs[i];
+    }
+
+    size_t i = m;
+
+    while (window != needle)
+    {
+        if (i == n)
         {
-            _strtok_next = NULL;
-            return (current_token);
+            return (NULL);
         }
-        else
+
+        window = ((window << 8) | cs[i]) & mask;
+        ++i;
+    }
+
+    /* The window holds the m bytes before i. */
+    return ((void*) (cs + i - m));
+}
+
+static void* search_two_way(
+    const uint8_t* cs,
+    size_t n,
+    const uint8_t* ct,
+    size_t m)
+{
+    size_t period;
+    size_t period_reversed;
+    size_t suffix = find_maximal_suffix(ct, m, false, &period);
+    size_t suffix_reversed = find_maximal_suffix(
+        ct,
+        m,
+        true,
+        &period_reversed);
+
+    /* The later of the two suffixes gives a critical factorization: the
+     * needle splits into ct[0, suffix) and ct[suffix, m). */
+    if (suffix_reversed > suffix)
+    {
+        suffix = suffix_reversed;
+        period = period_reversed;
+    }
+
+    if (memcmp(ct, ct + period, suffix) == 0)
+    {
+        /* The needle is periodic. After a full match the next period is
+         * known to match already, which memory records to keep the search
+         * linear. */
+        size_t memory = 0;
+
+        for (size_t j = 0; j <= n - m;)
         {
-            *token_end = '\0';
-            _strtok_next = token_end + 1;
+            size_t i = (suffix > memory) ? suffix : memory;
 
-            return (current_token);
+            while (i < m && ct[i] == cs[i + j])
+            {
+                ++i;
+            }
+
+            if (i < m)
+            {
+                j += i - suffix + 1;
+                memory = 0;
+                continue;
+            }
+
+            /* The right half matches; the left half is checked backwards
+             * down to what memory already covers. */
+            i = suffix;
+
+            while (i > memory && ct[i - 1] == cs[i - 1 + j])
+            {
+                --i;
+            }
+
+            if (i <= memory)
+            {
+                return ((void*) (cs + j));
+            }
+
+            j += period;
+            memory = m - period;
         }
     }
-    /* If tokenizing new string. */
     else
     {
-        char* token_end = strpbrk(s, ct);
+        /* Halves of a non-periodic needle cannot overlap a match by more
+         * than this, so the search may shift by it. */
+        period = ((suffix > m - suffix) ? suffix : m - suffix) + 1;
 
-        /* If there are no more tokens. */
-        if (token_end == NULL)
+        for (size_t j = 0; j <= n - m;)
         {
-            _strtok_next = NULL;
-            return (s);
+            size_t i = suffix;
+
+            while (i < m && ct[i] == cs[i + j])
+            {
+                ++i;
+            }
+
+            if (i < m)
+            {
+                j += i - suffix + 1;
+                continue;
+            }
+
+            i = suffix;
+
+            while (i > 0 && ct[i - 1] == cs[i - 1 + j])
+            {
+                --i;
+            }
+
+            if (i == 0)
+            {
+                return ((void*) (cs + j));
+            }
+
+            j += period;
+        }
+    }
+
+    return (NULL);
+}
+
+static size_t find_maximal_suffix(
+    const uint8_t* ct,
+    size_t m,
+    bool reversed,
+    size_t* period)
+{
+    /* The suffix starts after start, which begins before the needle. */
+    size_t start = SIZE_MAX;
+    size_t j = 0;
+    size_t k = 1;
+    size_t p = 1;
+
+    while (j + k < m)
+    {
+        uint8_t a = ct[j + k];
+        uint8_t b = ct[start + k];
+
+        if ((reversed) ? (a > b) : (a < b))
+        {
+            /* The suffix so far is greater; extends its period. */
+            j += k;
+            k = 1;
+            p = j - start;
+        }
+        else if (a == b)
+        {
+            if (k != p)
+            {
+                ++k;
+            }
+            else
+            {
+                j += p;
+                k = 1;
+            }
         }
-        /* If there are more tokens. */
         else
         {
-            *token_end = '\0';
-            _strtok_next = token_end + 1;
-            return (s);
+            /* A greater suffix starts at j. */
+            start = j;
+            ++j;
+            k = 1;
+            p = 1;
         }
     }
+
+    *period = p;
+    return (start + 1);
 }
@@ -0,0 +1,182 @@
+/*
+ * arena.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <stdlib.h>
+
+#include <globals.h>
+#include <boot/kernel/memory/arena.h>
+
+/**
+ * @brief Allocates a chunk.
+ *
+ * @param size Usable bytes the chunk must hold, at least.
+ *
+ * @return New chunk, or NULL if memory is exhausted.
+ */
+static Arena_Chunk* chunk_create(size_t size);
+
+/**
+ * @brief Allocates memory once the current chunk is exhausted, moving on to
+ * a kept chunk that fits or linking in a new one.
+ *
+ * @param arena Arena to allocate from.
+ * @param size Size in bytes.
+ * @param alignment Alignment in bytes.
+ *
+ * @return Pointer to the memory, or NULL if memory is exhausted.
+ */
+static void* allocate_slow(Arena* arena, size_t size, size_t alignment);
+
+Arena* arena_create(void)
+{
+    Arena_Chunk* chunk = chunk_create(ARENA_CHUNK_SIZE - sizeof(Arena_Chunk));
+
+    if (chunk == NULL)
+    {
+        return (NULL);
+    }
+
+    Arena* arena = (Arena*) (chunk + 1);
+
+    arena->first = chunk;
+    arena_reset(arena);
+
+    return (arena);
+}
+
+void* arena_allocate(Arena* arena, size_t size)
+{
+    return (arena_allocate_aligned(arena, size, ARENA_ALIGNMENT));
+}
+
+void* arena_allocate_aligned(Arena* arena, size_t size, size_t alignment)
+{
+    uintptr_t ret = (arena->next + alignment - 1) & ~(alignment - 1);
+
+    /* ret is below next only if rounding up wrapped around. */
+    if (LIKELY(ret >= arena->next && ret <= arena->end
+        && size <= arena->end - ret))
+    {
+        arena->next = ret + size;
+        return ((void*) ret);
+    }
+
+    return (allocate_slow(arena, size, alignment));
+}
+
+void arena_reset(Arena* arena)
+{
+    Arena_Chunk* first = arena->first;
+
+    arena->current = first;
+    arena->next = (uintptr_t) (arena + 1);
+    arena->end = (uintptr_t) (first + 1) + first->size;
+}
+
+void arena_destroy(Arena* arena)
+{
+    if (arena == NULL)
+    {
+        return;
+    }
+
+    /* The arena lives in the first chunk, so the chain is read first. */
+    Arena_Chunk* chunk = arena->first;
+
+    while (chunk != NULL)
+    {
+        Arena_Chunk* next = chunk->next;
+
+        free(chunk);
+        chunk = next;
+    }
+}
+
+static Arena_Chunk* chunk_create(size_t size)
+{
+    if (UNLIKELY(size > SIZE_MAX - sizeof(Arena_Chunk)))
+    {
+        return (NULL);
+    }
+
+    Arena_Chunk* chunk = malloc(sizeof(Arena_Chunk) + size);
+
+    if (chunk == NULL)
+    {
+        return (NULL);
+    }
+
+    chunk->next = NULL;
+    chunk->size = size;
+
+    return (chunk);
+}
+
+static void* allocate_slow(Arena* arena, size_t size, size_t alignment)
+{
+    /* Room for the worst-case alignment padding. The chunk header must fit
+     * in front of it without the total wrapping around. */
+    size_t needed = size + alignment - 1;
+
+    if (UNLIKELY(needed < size || needed > SIZE_MAX - sizeof(Arena_Chunk)))
+    {
+        return (NULL);
+    }
+
+    Arena_Chunk* current = arena->current;
+    Arena_Chunk* chunk = current->next;
+
+    /* Chunks kept from before a reset are reused if they fit; otherwise a
+     * new chunk goes in front of them, and they wait for a later request. */
+    if (chunk == NULL || chunk->size < needed)
+    {
+        size_t chunk_size = ARENA_CHUNK_SIZE - sizeof(Arena_Chunk);
+
+        if (needed > chunk_size)
+        {
+            chunk_size = needed;
+        }
+
+        Arena_Chunk* created = chunk_create(chunk_size);
+
+        if (created == NULL)
+        {
+            return (NULL);
+        }
+
+        created->next = chunk;
+        current->next = created;
+        chunk = created;
+    }
+
+    uintptr_t start = (uintptr_t) (chunk + 1);
+    uintptr_t ret = (start + alignment - 1) & ~(alignment - 1);
+
+    arena->current = chunk;
+    arena->next = ret + size;
+    arena->end = start + chunk->size;
+
+    return ((void*) ret);
+}
@@ -0,0 +1,118 @@
+/*
+ * arena.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Size of the chunks an arena grows by, in bytes. Larger requests
+ * get a chunk of their own.
+ */
+#define ARENA_CHUNK_SIZE 4096
+
+/**
+ * @brief Alignment of memory returned by arena_allocate.
+ */
+#define ARENA_ALIGNMENT 8
+
+/**
+ * @brief Block of memory an arena hands out from. The usable memory follows
+ * the header.
+ */
+typedef struct Arena_Chunk
+{
+    /* Next chunk of the arena. Chunks after the current one are empty and
+     * kept for reuse after a reset. */
+    struct Arena_Chunk* next;
+
+    /* Usable bytes following the header. */
+    size_t size;
+} Arena_Chunk;
+
+/**
+ * @brief Region of memory whose allocations are all released together. The
+ * arena lives at the start of its first chunk.
+ */
+typedef struct Arena
+{
+    /* First chunk, which holds the arena itself. */
+    Arena_Chunk* first;
+
+    /* Chunk allocations are currently taken from. */
+    Arena_Chunk* current;
+
+    /* Next free byte of the current chunk. */
+    uintptr_t next;
+
+    /* End of the current chunk. */
+    uintptr_t end;
+} Arena;
+
+/**
+ * @brief Creates an empty arena.
+ *
+ * @return New arena, or NULL if memory is exhausted.
+ */
+Arena* arena_create(void);
+
+/**
+ * @brief Allocates memory from an arena, aligned to ARENA_ALIGNMENT. The
+ * memory cannot be freed on its own; it is released by arena_reset or
+ * arena_destroy.
+ *
+ * @param arena Arena to allocate from.
+ * @param size Size in bytes.
+ *
+ * @return Pointer to the memory, or NULL if memory is exhausted.
+ */
+void* arena_allocate(Arena* arena, size_t size);
+
+/**
+ * @brief Allocates memory from an arena with a given alignment.
+ *
+ * @param arena Arena to allocate from.
+ * @param size Size in bytes.
+ * @param alignment Alignment in bytes. Must be a power of two.
+ *
+ * @return Pointer to the memory, or NULL if memory is exhausted.
+ */
+void* arena_allocate_aligned(Arena* arena, size_t size, size_t alignment);
+
+/**
+ * @brief Releases every allocation of an arena at once. The chunks are kept,
+ * so that refilling the arena does not go back to the heap.
+ *
+ * @param arena Arena to reset.
+ */
+void arena_reset(Arena* arena);
+
+/**
+ * @brief Releases every allocation of an arena and the arena itself.
+ *
+ * @param arena Arena to destroy. Does nothing if NULL.
+ */
+void arena_destroy(Arena* arena);
+
+#endif /* ARENA_H_INCLUDED */
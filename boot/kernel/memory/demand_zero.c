@@ -0,0 +1,235 @@
+/*
+ * demand_zero.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string.h>
+
+#include <globals.h>
+#include <boot/kernel/interrupts/page_fault.h>
+#include <boot/kernel/memory/demand_zero.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/paging.h>
+#include <boot/kernel/memory/zero_pool.h>
+
+/**
+ * @brief Range of virtual memory backed on first touch.
+ */
+typedef struct Demand_Zero_Region
+{
+    /* Page-aligned start of the region. */
+    uintptr_t base;
+
+    /* Size of the region in bytes, excluding its guard page. */
+    size_t size;
+
+    /* PAGING_* flags the backing pages are mapped with. */
+    uint32_t flags;
+} Demand_Zero_Region;
+
+/**
+ * @brief Finds the region containing an address.
+ *
+ * @param address Virtual address.
+ *
+ * @return Region containing the address, or NULL if there is none.
+ */
+static Demand_Zero_Region* find_region(uintptr_t address);
+
+/**
+ * @brief Regions currently reserved, sorted by base address.
+ */
+static Demand_Zero_Region regions[DEMAND_ZERO_REGION_COUNT];
+
+/**
+ * @brief Number of regions currently reserved.
+ */
+static size_t region_count;
+
+/**
+ * @brief Number of frames currently backing regions.
+ */
+static size_t resident_count;
+
+void* demand_zero_reserve(size_t size, uint32_t flags)
+{
+    if (UNLIKELY(size == 0 || region_count == DEMAND_ZERO_REGION_COUNT
+        || size > DEMAND_ZERO_END - DEMAND_ZERO_BASE))
+    {
+        return (NULL);
+    }
+
+    size = (size + PAGING_PAGE_SIZE - 1) & ~(PAGING_PAGE_SIZE - 1);
+
+    /* First fit over the gaps between regions, each of which keeps one
+     * guard page after it. */
+    uintptr_t base = DEMAND_ZERO_BASE;
+    size_t index = 0;
+
+    while (index < region_count)
+    {
+        if (regions[index].base - base >= size + PAGING_PAGE_SIZE)
+        {
+            break;
+        }
+
+        base = regions[index].base + regions[index].size + PAGING_PAGE_SIZE;
+        ++index;
+    }
+
+    if (DEMAND_ZERO_END - base < size + PAGING_PAGE_SIZE)
+    {
+        return (NULL);
+    }
+
+    memmove(
+        &regions[index + 1],
+        &regions[index],
+        (region_count - index) * sizeof(Demand_Zero_Region));
+
+    regions[index].base = base;
+    regions[index].size = size;
+    regions[index].flags = flags;
+    ++region_count;
+
+    return ((void*) base);
+}
+
+void demand_zero_release(void* ptr)
+{
+    Demand_Zero_Region* region = find_region((uintptr_t) ptr);
+
+    if (UNLIKELY(region == NULL || region->base != (uintptr_t) ptr))
+    {
+        return;
+    }
+
+    bool unmapped = false;
+
+    for (uintptr_t page = region->base;
+        page < region->base + region->size;
+        page += PAGING_PAGE_SIZE)
+    {
+        uintptr_t physical;
+
+        if (!paging_get_physical(page, &physical))
+        {
+            continue;
+        }
+
+        paging_unmap_deferred(page);
+        frame_allocator_free(physical, 0);
+        --resident_count;
+        unmapped = true;
+    }
+
+    /* Region pages are never global, so one reload drops them all. */
+    if (unmapped)
+    {
+        paging_flush();
+    }
+
+    size_t index = (size_t) (region - regions);
+
+    memmove(
+        &regions[index],
+        &regions[index + 1],
+        (region_count - index - 1) * sizeof(Demand_Zero_Region));
+    --region_count;
+}
+
+bool demand_zero_handle_fault(uintptr_t address, uint32_t error)
+{
+    /* Only missing pages are backed; protection faults are real bugs. */
+    if ((error & (PAGE_FAULT_PRESENT | PAGE_FAULT_RESERVED)) != 0)
+    {
+        return (false);
+    }
+
+    Demand_Zero_Region* region = find_region(address);
+
+    if (region == NULL)
+    {
+        return (false);
+    }
+
+    /* Frames zeroed ahead of time by the idle loop make the fault cheap. */
+    uintptr_t frame = zero_pool_allocate(0);
+
+    if (frame == 0)
+    {
+        frame = frame_allocator_allocate(0);
+
+        if (UNLIKELY(frame == 0))
+        {
+            return (false);
+        }
+
+        memset(PAGING_PHYSICAL_TO_VIRTUAL(frame), 0, PAGING_PAGE_SIZE);
+    }
+
+    if (UNLIKELY(!paging_map(
+        address & ~(PAGING_PAGE_SIZE - 1),
+        frame,
+        region->flags & ~PAGING_GLOBAL)))
+    {
+        frame_allocator_free(frame, 0);
+        return (false);
+    }
+
+    ++resident_count;
+
+    return (true);
+}
+
+size_t demand_zero_get_resident_count(void)
+{
+    return (resident_count);
+}
+
+static Demand_Zero_Region* find_region(uintptr_t address)
+{
+    size_t low = 0;
+    size_t high = region_count;
+
+    while (low < high)
+    {
+        size_t middle = (low + high) / 2;
+        Demand_Zero_Region* region = &regions[middle];
+
+        if (address < region->base)
+        {
+            high = middle;
+        }
+        else if (address - region->base >= region->size)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            return (region);
+        }
+    }
+
+    return (NULL);
+}
@@ -0,0 +1,85 @@
+/*
+ * demand_zero.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef DEMAND_ZERO_H_INCLUDED
+#define DEMAND_ZERO_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Start of the virtual window demand-zero regions are placed in.
+ */
+#define DEMAND_ZERO_BASE 0x10000000
+
+/**
+ * @brief End of the virtual window demand-zero regions are placed in.
+ */
+#define DEMAND_ZERO_END 0x40000000
+
+/**
+ * @brief Largest number of demand-zero regions that can exist at once.
+ */
+#define DEMAND_ZERO_REGION_COUNT 64
+
+/**
+ * @brief Reserves a region of kernel virtual memory that is backed by
+ * zeroed frames only when a page is first touched. Each region is followed
+ * by an unmapped guard page, so that overruns fault instead of running into
+ * the next region.
+ *
+ * @param size Size of the region, in bytes. Rounded up to whole pages.
+ * @param flags PAGING_* flags the backing pages are mapped with.
+ *
+ * @return Page-aligned start of the region, or NULL if the window or the
+ * region table is full.
+ */
+void* demand_zero_reserve(size_t size, uint32_t flags);
+
+/**
+ * @brief Releases a region, returning every frame that backs it. The TLB is
+ * flushed once for the whole region rather than once per page.
+ *
+ * @param ptr Start of the region, as returned by demand_zero_reserve.
+ */
+void demand_zero_release(void* ptr);
+
+/**
+ * @brief Backs a faulting page with a zeroed frame if it lies in a
+ * demand-zero region.
+ *
+ * @param address Faulting address, from CR2.
+ * @param error Page fault error code.
+ *
+ * @return True if the fault was resolved, false if it was not caused by a
+ * page of a demand-zero region, or no frame was available.
+ */
+bool demand_zero_handle_fault(uintptr_t address, uint32_t error);
+
+/**
+ * @brief Gets the number of frames currently backing demand-zero regions.
+ *
+ * @return Number of resident frames.
+ */
+size_t demand_zero_get_resident_count(void);
+
+#endif /* DEMAND_ZERO_H_INCLUDED */
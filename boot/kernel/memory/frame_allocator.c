@@ -0,0 +1,590 @@
+/*
+ * frame_allocator.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <globals.h>
+#include <boot/memory.h>
+#include <boot/memory_map.h>
+#include <boot/multiboot.h>
+#include <boot/kernel/kernel.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/paging.h>
+
+/**
+ * @brief Highest frame index that can be managed. Only memory covered by the
+ * direct map is handed out, so that every frame can be reached once paging
+ * is on.
+ */
+#define FRAME_INDEX_LIMIT \
+    (PAGING_DIRECT_MAP_SIZE >> FRAME_ALLOCATOR_FRAME_SHIFT)
+
+/**
+ * @brief Finds the frame index just past the highest available memory.
+ *
+ * @return Number of frames to keep bookkeeping for.
+ */
+static uint32_t find_frame_count(void);
+
+/**
+ * @brief Releases every available memory region above a given frame to
+ * the free lists.
+ *
+ * @param first Lowest frame index that may be released.
+ */
+static void release_available(uint32_t first);
+
+/**
+ * @brief Releases a range of frames, skipping the early boot arena and boot
+ * modules.
+ *
+ * @param start First frame index of the range.
+ * @param end Frame index just past the range.
+ * @param excluded First excluded range to check the range against.
+ */
+static void release_range(uint32_t start, uint32_t end, size_t excluded);
+
+/**
+ * @brief Gets a range of frames that must never be released. Range 0 is the
+ * memory handed out by the early boot arena, and the rest are boot modules.
+ *
+ * @param index Index of the excluded range.
+ * @param start Location to store the first frame index of the range in.
+ * @param end Location to store the frame index just past the range in.
+ *
+ * @return False if there is no excluded range with that index.
+ */
+static bool get_excluded(size_t index, uint32_t* start, uint32_t* end);
+
+/**
+ * @brief Frees a block, merging it with free buddies.
+ *
+ * @param index Frame index of the first frame of the block.
+ * @param order Order of the block.
+ */
+static void release_block(uint32_t index, size_t order);
+
+/**
+ * @brief Pushes a block onto the free list of its order.
+ *
+ * @param index Frame index of the first frame of the block.
+ * @param order Order of the block.
+ */
+static void list_push(uint32_t index, size_t order);
+
+/**
+ * @brief Unlinks a block from the free list of its order.
+ *
+ * @param index Frame index of the first frame of the block.
+ * @param order Order of the block.
+ */
+static void list_remove(uint32_t index, size_t order);
+
+/**
+ * @brief Bookkeeping for every managed frame, indexed by frame number.
+ */
+static Frame* frames;
+
+/**
+ * @brief Number of entries in frames.
+ */
+static uint32_t frame_count;
+
+/**
+ * @brief Number of frames currently on the free lists.
+ */
+static size_t free_count;
+
+/**
+ * @brief Head of the free list for every order.
+ */
+static uint32_t free_list[FRAME_ALLOCATOR_ORDER_COUNT];
+
+/**
+ * @brief Number of blocks on the free list for every order.
+ */
+static size_t free_block_count[FRAME_ALLOCATOR_ORDER_COUNT];
+
+void frame_allocator_initialize(void)
+{
+    frame_count = find_frame_count();
+
+    /* Allocates bookkeeping for every frame from the early boot arena. */
+    frames = memory_allocate(frame_count * sizeof(Frame), 16);
+
+    /* Every frame starts out reserved, and only frames known to be
+     * available are released below. */
+    for (uint32_t i = 0; i < frame_count; ++i)
+    {
+        frames[i].next = FRAME_ALLOCATOR_NO_FRAME;
+        frames[i].prev = FRAME_ALLOCATOR_NO_FRAME;
+        frames[i].private = 0;
+        frames[i].order = 0;
+        frames[i].flags = FRAME_RESERVED;
+        frames[i].reserved = 0;
+    }
+
+    for (size_t order = 0; order <= FRAME_ALLOCATOR_MAX_ORDER; ++order)
+    {
+        free_list[order] = FRAME_ALLOCATOR_NO_FRAME;
+        free_block_count[order] = 0;
+    }
+    free_count = 0;
+
+    /* Low memory and the kernel image stay reserved. Everything past the
+     * image is released, apart from what the arena handed out (including
+     * the bookkeeping above) and the boot modules. */
+    release_available(
+        (uint32_t) ((uintptr_t) __kernel_end >> FRAME_ALLOCATOR_FRAME_SHIFT));
+}
+
+uintptr_t frame_allocator_allocate(size_t order)
+{
+    if (UNLIKELY(order > FRAME_ALLOCATOR_MAX_ORDER))
+    {
+        return (0);
+    }
+
+    /* Finds the smallest order with a free block. */
+    size_t found = order;
+    while (free_list[found] == FRAME_ALLOCATOR_NO_FRAME)
+    {
+        ++found;
+        if (found > FRAME_ALLOCATOR_MAX_ORDER)
+        {
+            return (0);
+        }
+    }
+
+    uint32_t index = free_list[found];
+    list_remove(index, found);
+    frames[index].flags &= ~FRAME_FREE;
+
+    /* Splits the block, returning the upper half to the free lists each
+     * time, until it is the requested order. */
+    while (found > order)
+    {
+        --found;
+        list_push(index + (1 << found), found);
+    }
+
+    frames[index].order = order;
+    frames[index].private = 0;
+    free_count -= (1 << order);
+
+    return ((uintptr_t) index << FRAME_ALLOCATOR_FRAME_SHIFT);
+}
+
+void frame_allocator_free(uintptr_t address, size_t order)
+{
+    static char frame_free_error[]
+        = "\nFATAL ERROR: INVALID FRAME FREE.\n";
+
+    uint32_t index = address >> FRAME_ALLOCATOR_FRAME_SHIFT;
+
+    if (UNLIKELY(
+        (index >= frame_count)
+        || (order > FRAME_ALLOCATOR_MAX_ORDER)
+        || ((frames[index].flags & (FRAME_FREE | FRAME_RESERVED)) != 0)))
+    {
+        kernel_panic(frame_free_error, sizeof(frame_free_error) - 1);
+    }
+
+    free_count += (1 << order);
+    release_block(index, order);
+}
+
+bool frame_allocator_grow(uintptr_t address, size_t order, size_t new_order)
+{
+    uint32_t index = address >> FRAME_ALLOCATOR_FRAME_SHIFT;
+
+    if (new_order > FRAME_ALLOCATOR_MAX_ORDER)
+    {
+        return (false);
+    }
+
+    /* The block must be the lower half at every level, with a whole free
+     * buddy above it. Everything is checked before anything is taken. */
+    for (size_t level = order; level < new_order; ++level)
+    {
+        uint32_t buddy = index + (1u << level);
+
+        if (((index & (1u << level)) != 0)
+            || ((buddy + (1u << level)) > frame_count)
+            || ((frames[buddy].flags & FRAME_FREE) == 0)
+            || (frames[buddy].order != level))
+        {
+            return (false);
+        }
+    }
+
+    for (size_t level = order; level < new_order; ++level)
+    {
+        uint32_t buddy = index + (1u << level);
+
+        list_remove(buddy, level);
+        frames[buddy].flags &= ~FRAME_FREE;
+        free_count -= (1u << level);
+    }
+
+    frames[index].order = new_order;
+
+    return (true);
+}
+
+void frame_allocator_shrink(
+    uintptr_t address,
+    size_t order,
+    size_t new_order)
+{
+    uint32_t index = address >> FRAME_ALLOCATOR_FRAME_SHIFT;
+
+    /* Releases the upper half until the block is the requested order. The
+     * halves cannot merge with anything, since their buddies are still
+     * allocated. */
+    while (order > new_order)
+    {
+        --order;
+        list_push(index + (1u << order), order);
+        free_count += (1u << order);
+    }
+
+    frames[index].order = new_order;
+}
+
+size_t frame_allocator_get_order(size_t size)
+{
+    size_t order = 0;
+
+    while (((size_t) FRAME_ALLOCATOR_FRAME_SIZE << order) < size)
+    {
+        ++order;
+        if (order > FRAME_ALLOCATOR_MAX_ORDER)
+        {
+            break;
+        }
+    }
+
+    return (order);
+}
+
+Frame* frame_allocator_get_frame(uintptr_t address)
+{
+    uint32_t index = address >> FRAME_ALLOCATOR_FRAME_SHIFT;
+
+    if (index >= frame_count)
+    {
+        return (NULL);
+    }
+
+    return (&frames[index]);
+}
+
+size_t frame_allocator_get_free_count(void)
+{
+    return (free_count);
+}
+
+size_t frame_allocator_get_frame_count(void)
+{
+    return (frame_count);
+}
+
+size_t frame_allocator_get_block_count(size_t order)
+{
+    if (order > FRAME_ALLOCATOR_MAX_ORDER)
+    {
+        return (0);
+    }
+
+    return (free_block_count[order]);
+}
+
+size_t frame_allocator_get_largest_run(void)
+{
+    size_t largest = 0;
+    size_t run = 0;
+    uint32_t index = 0;
+
+    /* Free blocks are only marked on their first frame, so whole blocks are
+     * stepped over at once. */
+    while (index < frame_count)
+    {
+        if ((frames[index].flags & FRAME_FREE) != 0)
+        {
+            size_t size = (size_t) 1 << frames[index].order;
+
+            run += size;
+            index += size;
+
+            if (run > largest)
+            {
+                largest = run;
+            }
+        }
+        else
+        {
+            run = 0;
+            ++index;
+        }
+    }
+
+    return (largest);
+}
+
+static uint32_t find_frame_count(void)
+{
+    uint64_t top = 0;
+
+    if ((multiboot_info_structure.flags & MULTIBOOT_FLAG_MEMORY_MAP) != 0)
+    {
+        uintptr_t entry = multiboot_info_structure.mmap_addr;
+        uintptr_t entry_end = entry + multiboot_info_structure.mmap_length;
+
+        while (entry < entry_end)
+        {
+            memory_map_t* region = (memory_map_t*) entry;
+
+            if (region->type == MULTIBOOT_MEMORY_AVAILABLE)
+            {
+                uint64_t base = ((uint64_t) region->base_addr_high << 32)
+                    | region->base_addr_low;
+                uint64_t length = ((uint64_t) region->length_high << 32)
+                    | region->length_low;
+
+                if ((base + length) > top)
+                {
+                    top = base + length;
+                }
+            }
+
+            /* The size field does not count itself. */
+            entry += region->size + sizeof(region->size);
+        }
+    }
+    else if ((multiboot_info_structure.flags & MULTIBOOT_FLAG_MEMORY) != 0)
+    {
+        /* Upper memory starts at 1 MiB and is given in KiB. */
+        top = (1024 * 1024)
+            + ((uint64_t) multiboot_info_structure.mem_upper * 1024);
+    }
+
+    top >>= FRAME_ALLOCATOR_FRAME_SHIFT;
+    if (top > FRAME_INDEX_LIMIT)
+    {
+        top = FRAME_INDEX_LIMIT;
+    }
+
+    return ((uint32_t) top);
+}
+
+static void release_available(uint32_t first)
+{
+    if ((multiboot_info_structure.flags & MULTIBOOT_FLAG_MEMORY_MAP) != 0)
+    {
+        uintptr_t entry = multiboot_info_structure.mmap_addr;
+        uintptr_t entry_end = entry + multiboot_info_structure.mmap_length;
+
+        while (entry < entry_end)
+        {
+            memory_map_t* region = (memory_map_t*) entry;
+
+            if ((region->type == MULTIBOOT_MEMORY_AVAILABLE)
+                && (region->base_addr_high == 0))
+            {
+                uint64_t base = region->base_addr_low;
+                uint64_t length = ((uint64_t) region->length_high << 32)
+                    | region->length_low;
+
+                /* Only whole frames inside the region are usable. */
+                uint64_t start = (base + FRAME_ALLOCATOR_FRAME_SIZE - 1)
+                    >> FRAME_ALLOCATOR_FRAME_SHIFT;
+                uint64_t end = (base + length) >> FRAME_ALLOCATOR_FRAME_SHIFT;
+
+                if (start < first)
+                {
+                    start = first;
+                }
+                if (end > frame_count)
+                {
+                    end = frame_count;
+                }
+                if (start < end)
+                {
+                    release_range((uint32_t) start, (uint32_t) end, 0);
+                }
+            }
+
+            entry += region->size + sizeof(region->size);
+        }
+    }
+    else if ((multiboot_info_structure.flags & MULTIBOOT_FLAG_MEMORY) != 0)
+    {
+        uint32_t start = (1024 * 1024) >> FRAME_ALLOCATOR_FRAME_SHIFT;
+
+        if (start < first)
+        {
+            start = first;
+        }
+        if (start < frame_count)
+        {
+            release_range(start, frame_count, 0);
+        }
+    }
+}
+
+static void release_range(uint32_t start, uint32_t end, size_t excluded)
+{
+    uint32_t excluded_start;
+    uint32_t excluded_end;
+
+    /* Splits the range around the first excluded range that overlaps it. */
+    for (; get_excluded(excluded, &excluded_start, &excluded_end); ++excluded)
+    {
+        if ((excluded_start < end) && (excluded_end > start))
+        {
+            if (start < excluded_start)
+            {
+                release_range(start, excluded_start, excluded + 1);
+            }
+            if (excluded_end < end)
+            {
+                release_range(excluded_end, end, excluded + 1);
+            }
+            return;
+        }
+    }
+
+    for (uint32_t i = start; i < end; ++i)
+    {
+        frames[i].flags &= ~FRAME_RESERVED;
+    }
+    free_count += end - start;
+
+    /* Carves the range into the largest naturally aligned blocks. */
+    while (start < end)
+    {
+        size_t order = 0;
+
+        while ((order < FRAME_ALLOCATOR_MAX_ORDER)
+            && ((start & ((2u << order) - 1)) == 0)
+            && ((start + (2u << order)) <= end))
+        {
+            ++order;
+        }
+
+        release_block(start, order);
+        start += (1u << order);
+    }
+}
+
+static bool get_excluded(size_t index, uint32_t* start, uint32_t* end)
+{
+    if (index == 0)
+    {
+        *start = (uint32_t) ((uintptr_t) memory_start
+            >> FRAME_ALLOCATOR_FRAME_SHIFT);
+        *end = (uint32_t) (((uintptr_t) memory_location
+            + FRAME_ALLOCATOR_FRAME_SIZE - 1) >> FRAME_ALLOCATOR_FRAME_SHIFT);
+        return (true);
+    }
+
+    if (((multiboot_info_structure.flags & MULTIBOOT_FLAG_MODULES) == 0)
+        || (index > multiboot_info_structure.mods_count))
+    {
+        return (false);
+    }
+
+    module_t* module = &((module_t*) multiboot_info_structure.mods_addr)
+        [index - 1];
+
+    *start = module->mod_start >> FRAME_ALLOCATOR_FRAME_SHIFT;
+    *end = (module->mod_end + FRAME_ALLOCATOR_FRAME_SIZE - 1)
+        >> FRAME_ALLOCATOR_FRAME_SHIFT;
+
+    return (true);
+}
+
+static void release_block(uint32_t index, size_t order)
+{
+    while (order < FRAME_ALLOCATOR_MAX_ORDER)
+    {
+        uint32_t buddy = index ^ (1u << order);
+
+        if (((buddy + (1u << order)) > frame_count)
+            || ((frames[buddy].flags & FRAME_FREE) == 0)
+            || (frames[buddy].order != order))
+        {
+            break;
+        }
+
+        list_remove(buddy, order);
+        frames[buddy].flags &= ~FRAME_FREE;
+
+        index &= ~(1u << order);
+        ++order;
+    }
+
+    list_push(index, order);
+}
+
+static void list_push(uint32_t index, size_t order)
+{
+    Frame* frame = &frames[index];
+
+    frame->order = order;
+    frame->flags |= FRAME_FREE;
+    frame->prev = FRAME_ALLOCATOR_NO_FRAME;
+    frame->next = free_list[order];
+
+    if (frame->next != FRAME_ALLOCATOR_NO_FRAME)
+    {
+        frames[frame->next].prev = index;
+    }
+
+    free_list[order] = index;
+    ++free_block_count[order];
+}
+
+static void list_remove(uint32_t index, size_t order)
+{
+    Frame* frame = &frames[index];
+
+    if (frame->prev != FRAME_ALLOCATOR_NO_FRAME)
+    {
+        frames[frame->prev].next = frame->next;
+    }
+    else
+    {
+        free_list[order] = frame->next;
+    }
+
+    if (frame->next != FRAME_ALLOCATOR_NO_FRAME)
+    {
+        frames[frame->next].prev = frame->prev;
+    }
+
+    frame->next = FRAME_ALLOCATOR_NO_FRAME;
+    frame->prev = FRAME_ALLOCATOR_NO_FRAME;
+    --free_block_count[order];
+}
@@ -0,0 +1,204 @@
+/*
+ * frame_allocator.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef FRAME_ALLOCATOR_H_INCLUDED
+#define FRAME_ALLOCATOR_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Size of a physical frame, in bytes.
+ */
+#define FRAME_ALLOCATOR_FRAME_SIZE 4096
+
+/**
+ * @brief Base 2 logarithm of FRAME_ALLOCATOR_FRAME_SIZE.
+ */
+#define FRAME_ALLOCATOR_FRAME_SHIFT 12
+
+/**
+ * @brief Largest block order managed by the allocator. A block of order k
+ * is 2^k contiguous frames, so the largest block is 4 MiB.
+ */
+#define FRAME_ALLOCATOR_MAX_ORDER 10
+
+/**
+ * @brief Number of block orders managed by the allocator.
+ */
+#define FRAME_ALLOCATOR_ORDER_COUNT (FRAME_ALLOCATOR_MAX_ORDER + 1)
+
+/**
+ * @brief Value used in place of a frame index to mark the end of a list.
+ */
+#define FRAME_ALLOCATOR_NO_FRAME 0xFFFFFFFF
+
+/**
+ * @brief Frame flag set on the first frame of a free block.
+ */
+#define FRAME_FREE 0x01
+
+/**
+ * @brief Frame flag set on frames that are never handed out, such as
+ * firmware areas, the kernel image and boot modules.
+ */
+#define FRAME_RESERVED 0x02
+
+/**
+ * @brief Frame flag set on every frame of a slab. The private field of such
+ * frames points to the slab header.
+ */
+#define FRAME_SLAB 0x04
+
+/**
+ * @brief Bookkeeping kept for every physical frame. Only the first frame
+ * of a block carries meaningful list links and order; the owner of an
+ * allocated block may use the private field of any of its frames.
+ */
+typedef struct Frame
+{
+    /* Index of the next block in the free list of the same order. */
+    uint32_t next;
+
+    /* Index of the previous block in the free list of the same order. */
+    uint32_t prev;
+
+    /* Data owned by whoever allocated the block. */
+    uint32_t private;
+
+    /* Order of the block this frame begins, if it begins one. */
+    uint8_t order;
+
+    /* FRAME_* flags. */
+    uint8_t flags;
+
+    /* Padding to keep the structure at 16 bytes. */
+    uint16_t reserved;
+} Frame;
+
+/**
+ * @brief Builds the free lists from the Multiboot memory map. Low memory,
+ * the kernel image, every boot module and everything the early boot arena
+ * has handed out stay reserved. Bookkeeping for every frame is allocated
+ * from the arena, which must be handed off right after this call.
+ */
+void frame_allocator_initialize(void);
+
+/**
+ * @brief Allocates a block of 2^order physically contiguous frames. The
+ * block is aligned to its own size.
+ *
+ * @param order Order of the block to allocate.
+ *
+ * @return Physical address of the block, or 0 if no block of that order is
+ * available.
+ */
+uintptr_t frame_allocator_allocate(size_t order);
+
+/**
+ * @brief Returns a block to the allocator, merging it with its buddies.
+ *
+ * @param address Physical address of the block, as returned by
+ * frame_allocator_allocate.
+ * @param order Order the block was allocated with.
+ */
+void frame_allocator_free(uintptr_t address, size_t order);
+
+/**
+ * @brief Grows an allocated block in place by absorbing the free buddies
+ * that follow it. Nothing changes if any of them is in use.
+ *
+ * @param address Physical address of the block.
+ * @param order Order the block was allocated with.
+ * @param new_order Order to grow the block to.
+ *
+ * @return True if the block now has order new_order, false if it could not
+ * be grown.
+ */
+bool frame_allocator_grow(uintptr_t address, size_t order, size_t new_order);
+
+/**
+ * @brief Shrinks an allocated block in place, returning its upper part to
+ * the allocator.
+ *
+ * @param address Physical address of the block.
+ * @param order Order the block was allocated with.
+ * @param new_order Order to shrink the block to.
+ */
+void frame_allocator_shrink(
+    uintptr_t address,
+    size_t order,
+    size_t new_order);
+
+/**
+ * @brief Finds the smallest order whose blocks can hold a given size.
+ *
+ * @param size Size in bytes.
+ *
+ * @return Smallest sufficient order. Greater than FRAME_ALLOCATOR_MAX_ORDER
+ * if the size cannot be served by a single block.
+ */
+size_t frame_allocator_get_order(size_t size);
+
+/**
+ * @brief Gets the bookkeeping for the frame containing a physical address.
+ *
+ * @param address Physical address.
+ *
+ * @return Frame bookkeeping, or NULL if the address is beyond the managed
+ * memory.
+ */
+Frame* frame_allocator_get_frame(uintptr_t address);
+
+/**
+ * @brief Gets the number of frames currently free.
+ *
+ * @return Number of free frames.
+ */
+size_t frame_allocator_get_free_count(void);
+
+/**
+ * @brief Gets the number of frames covered by the allocator, free or not.
+ *
+ * @return Number of managed frames.
+ */
+size_t frame_allocator_get_frame_count(void);
+
+/**
+ * @brief Gets the number of free blocks of an order.
+ *
+ * @param order Order of the blocks.
+ *
+ * @return Number of free blocks of that order.
+ */
+size_t frame_allocator_get_block_count(size_t order);
+
+/**
+ * @brief Finds the longest run of physically contiguous free frames, which
+ * may span several free blocks. Walks the bookkeeping of every frame, so it
+ * is meant for diagnostics rather than allocation decisions.
+ *
+ * @return Number of frames in the longest free run.
+ */
+size_t frame_allocator_get_largest_run(void);
+
+#endif /* FRAME_ALLOCATOR_H_INCLUDED */
@@ -0,0 +1,500 @@
+/*
+ * magazine.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string.h>
+
+#include <globals.h>
+#include <boot/cpu.h>
+#include <boot/kernel/spinlock.h>
+#include <boot/kernel/memory/magazine.h>
+#include <boot/kernel/memory/slab.h>
+#include <boot/kernel/memory/vmalloc.h>
+
+/**
+ * @brief Stack of free objects of one size class.
+ */
+typedef struct Magazine
+{
+    /* Next magazine in a depot list. */
+    struct Magazine* next;
+
+    /* Number of objects held. */
+    size_t count;
+
+    /* Objects held, the most recently freed last. */
+    void* rounds[MAGAZINE_CAPACITY];
+} Magazine;
+
+/**
+ * @brief Magazines a CPU holds for one size class. Keeping a second
+ * magazine means a CPU alternating between allocating and freeing around a
+ * magazine boundary does not go to the depot every time.
+ */
+typedef struct Magazine_Cache
+{
+    /* Magazine objects are taken from and freed to. */
+    Magazine* loaded;
+
+    /* Magazine swapped in when the loaded one runs empty or full. */
+    Magazine* previous;
+} Magazine_Cache;
+
+/**
+ * @brief Magazines of every size class held by one CPU. Aligned so that no
+ * two CPUs share a cache line.
+ */
+typedef struct Magazine_Cpu
+{
+    Magazine_Cache caches[SLAB_CACHE_COUNT];
+} __attribute__((aligned(64))) Magazine_Cpu;
+
+/**
+ * @brief Magazines of one size class shared by all CPUs.
+ */
+typedef struct Magazine_Depot
+{
+    /* Protects the lists. */
+    Spinlock lock;
+
+    /* Magazines with MAGAZINE_CAPACITY objects. */
+    Magazine* full;
+
+    /* Magazines with no objects. */
+    Magazine* empty;
+} Magazine_Depot;
+
+/**
+ * @brief Takes an object when both magazines of a CPU are empty.
+ *
+ * @param cache Magazines of the calling CPU. Interrupts must be disabled.
+ * @param index Size class.
+ *
+ * @return Object, or NULL if no memory is left.
+ */
+static void* allocate_slow(Magazine_Cache* cache, size_t index);
+
+/**
+ * @brief Stores an object when both magazines of a CPU are full.
+ *
+ * @param cache Magazines of the calling CPU. Interrupts must be disabled.
+ * @param index Size class.
+ * @param ptr Object to store.
+ */
+static void free_slow(Magazine_Cache* cache, size_t index, void* ptr);
+
+/**
+ * @brief Calls slab_allocate under the slab lock, reclaiming the depot and
+ * retrying once if memory runs out.
+ *
+ * @param size Size of memory to allocate, in bytes.
+ *
+ * @return Pointer to allocated memory, or NULL.
+ */
+static void* locked_allocate(size_t size);
+
+/**
+ * @brief Calls slab_free under the slab lock.
+ *
+ * @param ptr Pointer to memory to free.
+ */
+static void locked_free(void* ptr);
+
+/**
+ * @brief Calls slab_get_size, under the slab lock for a block in the
+ * vmalloc window, whose region table moves whenever the window is
+ * allocated from. Any other block keeps its size while it is allocated, so
+ * needs no lock.
+ *
+ * @param ptr Pointer to allocated memory.
+ *
+ * @return Size of the block, in bytes.
+ */
+static size_t get_size(void* ptr);
+
+/**
+ * @brief Per-CPU magazines.
+ */
+static Magazine_Cpu cpus[CPU_MAX_COUNT];
+
+/**
+ * @brief Depot of every size class.
+ */
+static Magazine_Depot depots[SLAB_CACHE_COUNT];
+
+/**
+ * @brief Protects the slab allocator, which is not safe to enter from two
+ * CPUs at once.
+ */
+static Spinlock slab_lock;
+
+void* magazine_allocate(size_t size)
+{
+    if (UNLIKELY(size > SLAB_MAX_SIZE))
+    {
+        return (locked_allocate(size));
+    }
+
+    size_t index = slab_get_size_class(size);
+    uint32_t state = cpu_save_interrupts();
+    Magazine_Cache* cache = &cpus[cpu_get_id()].caches[index];
+    Magazine* loaded = cache->loaded;
+    void* ret;
+
+    if (LIKELY(loaded != NULL && loaded->count > 0))
+    {
+        ret = loaded->rounds[--loaded->count];
+    }
+    else
+    {
+        ret = allocate_slow(cache, index);
+    }
+
+    cpu_restore_interrupts(state);
+
+    return (ret);
+}
+
+void* magazine_allocate_zeroed(size_t size)
+{
+    if (UNLIKELY(size > SLAB_MAX_SIZE))
+    {
+        uint32_t state = cpu_save_interrupts();
+        spinlock_acquire(&slab_lock);
+        void* ret = slab_allocate_zeroed(size);
+        spinlock_release(&slab_lock);
+        cpu_restore_interrupts(state);
+
+        return (ret);
+    }
+
+    void* ret = magazine_allocate(size);
+
+    if (ret == NULL)
+    {
+        return (NULL);
+    }
+
+    return (memset(ret, 0, size));
+}
+
+void magazine_free(void* ptr)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    size_t size = get_size(ptr);
+
+    if (UNLIKELY(size > SLAB_MAX_SIZE))
+    {
+        locked_free(ptr);
+        return;
+    }
+
+    size_t index = slab_get_size_class(size);
+    uint32_t state = cpu_save_interrupts();
+    Magazine_Cache* cache = &cpus[cpu_get_id()].caches[index];
+    Magazine* loaded = cache->loaded;
+
+    if (LIKELY(loaded != NULL && loaded->count < MAGAZINE_CAPACITY))
+    {
+        loaded->rounds[loaded->count++] = ptr;
+    }
+    else
+    {
+        free_slow(cache, index, ptr);
+    }
+
+    cpu_restore_interrupts(state);
+}
+
+void* magazine_reallocate(void* ptr, size_t size)
+{
+    if (ptr == NULL)
+    {
+        return (magazine_allocate(size));
+    }
+
+    if (size == 0)
+    {
+        magazine_free(ptr);
+        return (NULL);
+    }
+
+    size_t old_size = get_size(ptr);
+
+    /* Large blocks are resized in place by the slab allocator when
+     * possible. */
+    if (old_size > SLAB_MAX_SIZE)
+    {
+        uint32_t state = cpu_save_interrupts();
+        spinlock_acquire(&slab_lock);
+        void* ret = slab_reallocate(ptr, size);
+        spinlock_release(&slab_lock);
+        cpu_restore_interrupts(state);
+
+        return (ret);
+    }
+
+    /* Slack in the size class absorbs the growth. */
+    if (size <= old_size)
+    {
+        return (ptr);
+    }
+
+    void* ret = magazine_allocate(size);
+
+    if (ret == NULL)
+    {
+        return (NULL);
+    }
+
+    memcpy(ret, ptr, old_size);
+    magazine_free(ptr);
+
+    return (ret);
+}
+
+void magazine_reclaim(void)
+{
+    for (size_t index = 0; index < SLAB_CACHE_COUNT; ++index)
+    {
+        Magazine_Depot* depot = &depots[index];
+        uint32_t state = cpu_save_interrupts();
+
+        spinlock_acquire(&depot->lock);
+        Magazine* full = depot->full;
+        Magazine* empty = depot->empty;
+        depot->full = NULL;
+        depot->empty = NULL;
+        spinlock_release(&depot->lock);
+
+        spinlock_acquire(&slab_lock);
+        while (full != NULL)
+        {
+            Magazine* next = full->next;
+
+            for (size_t i = 0; i < full->count; ++i)
+            {
+                slab_free(full->rounds[i]);
+            }
+            slab_free(full);
+
+            full = next;
+        }
+        while (empty != NULL)
+        {
+            Magazine* next = empty->next;
+
+            slab_free(empty);
+            empty = next;
+        }
+        spinlock_release(&slab_lock);
+
+        cpu_restore_interrupts(state);
+    }
+}
+
+size_t magazine_get_cached_count(size_t index)
+{
+    size_t count = 0;
+    uint32_t state = cpu_save_interrupts();
+
+    for (size_t cpu = 0; cpu < CPU_MAX_COUNT; ++cpu)
+    {
+        Magazine_Cache* cache = &cpus[cpu].caches[index];
+
+        if (cache->loaded != NULL)
+        {
+            count += cache->loaded->count;
+        }
+        if (cache->previous != NULL)
+        {
+            count += cache->previous->count;
+        }
+    }
+
+    Magazine_Depot* depot = &depots[index];
+
+    spinlock_acquire(&depot->lock);
+    for (Magazine* full = depot->full; full != NULL; full = full->next)
+    {
+        count += full->count;
+    }
+    spinlock_release(&depot->lock);
+
+    cpu_restore_interrupts(state);
+
+    return (count);
+}
+
+static void* allocate_slow(Magazine_Cache* cache, size_t index)
+{
+    Magazine* previous = cache->previous;
+
+    if (previous != NULL && previous->count > 0)
+    {
+        cache->previous = cache->loaded;
+        cache->loaded = previous;
+
+        return (previous->rounds[--previous->count]);
+    }
+
+    /* Both magazines are empty: trades the previous one for a full one
+     * from the depot. */
+    Magazine_Depot* depot = &depots[index];
+
+    spinlock_acquire(&depot->lock);
+    Magazine* full = depot->full;
+    if (full != NULL)
+    {
+        depot->full = full->next;
+
+        if (previous != NULL)
+        {
+            previous->next = depot->empty;
+            depot->empty = previous;
+        }
+    }
+    spinlock_release(&depot->lock);
+
+    if (full == NULL)
+    {
+        return (locked_allocate((size_t) SLAB_MIN_SIZE << index));
+    }
+
+    cache->previous = cache->loaded;
+    cache->loaded = full;
+
+    return (full->rounds[--full->count]);
+}
+
+static void free_slow(Magazine_Cache* cache, size_t index, void* ptr)
+{
+    Magazine* loaded = cache->loaded;
+    Magazine* previous = cache->previous;
+
+    if (previous != NULL && previous->count < MAGAZINE_CAPACITY)
+    {
+        cache->previous = loaded;
+        cache->loaded = previous;
+        previous->rounds[previous->count++] = ptr;
+
+        return;
+    }
+
+    /* Both magazines are full (or missing): trades the previous one for an
+     * empty one from the depot, or a new one. */
+    Magazine_Depot* depot = &depots[index];
+    bool retire = loaded != NULL && previous != NULL;
+
+    spinlock_acquire(&depot->lock);
+    Magazine* empty = depot->empty;
+    if (empty != NULL)
+    {
+        depot->empty = empty->next;
+    }
+    spinlock_release(&depot->lock);
+
+    if (empty == NULL)
+    {
+        empty = locked_allocate(sizeof(Magazine));
+
+        if (UNLIKELY(empty == NULL))
+        {
+            locked_free(ptr);
+            return;
+        }
+    }
+
+    if (retire)
+    {
+        spinlock_acquire(&depot->lock);
+        previous->next = depot->full;
+        depot->full = previous;
+        spinlock_release(&depot->lock);
+    }
+
+    if (loaded != NULL)
+    {
+        cache->previous = loaded;
+    }
+
+    empty->count = 0;
+    empty->rounds[empty->count++] = ptr;
+    cache->loaded = empty;
+}
+
+static void* locked_allocate(size_t size)
+{
+    uint32_t state = cpu_save_interrupts();
+
+    spinlock_acquire(&slab_lock);
+    void* ret = slab_allocate(size);
+    spinlock_release(&slab_lock);
+
+    if (UNLIKELY(ret == NULL))
+    {
+        magazine_reclaim();
+
+        spinlock_acquire(&slab_lock);
+        ret = slab_allocate(size);
+        spinlock_release(&slab_lock);
+    }
+
+    cpu_restore_interrupts(state);
+
+    return (ret);
+}
+
+static void locked_free(void* ptr)
+{
+    uint32_t state = cpu_save_interrupts();
+
+    spinlock_acquire(&slab_lock);
+    slab_free(ptr);
+    spinlock_release(&slab_lock);
+
+    cpu_restore_interrupts(state);
+}
+
+static size_t get_size(void* ptr)
+{
+    if (LIKELY(!vmalloc_contains(ptr)))
+    {
+        return (slab_get_size(ptr));
+    }
+
+    uint32_t state = cpu_save_interrupts();
+
+    spinlock_acquire(&slab_lock);
+    size_t size = slab_get_size(ptr);
+    spinlock_release(&slab_lock);
+
+    cpu_restore_interrupts(state);
+
+    return (size);
+}
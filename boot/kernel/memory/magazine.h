@@ -0,0 +1,99 @@
+/*
+ * magazine.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef MAGAZINE_H_INCLUDED
+#define MAGAZINE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Number of objects a magazine holds. Chosen so that a magazine fills
+ * a 128-byte size class.
+ */
+#define MAGAZINE_CAPACITY 30
+
+/**
+ * @brief Allocates memory. Size-class objects come from a magazine of the
+ * calling CPU, with interrupts disabled only for the few instructions this
+ * takes. A CPU whose magazines run dry swaps in a full one from the shared
+ * depot, and only goes to the slab allocator when the depot is empty too.
+ *
+ * @param size Size of memory to allocate, in bytes.
+ *
+ * @return Pointer to allocated memory, or NULL if the request cannot be
+ * satisfied.
+ */
+void* magazine_allocate(size_t size);
+
+/**
+ * @brief Allocates zeroed memory. Small objects come from the magazines and
+ * are cleared on the spot; large blocks come from slab_allocate_zeroed.
+ *
+ * @param size Size of memory to allocate, in bytes.
+ *
+ * @return Pointer to zeroed memory, or NULL if the request cannot be
+ * satisfied.
+ */
+void* magazine_allocate_zeroed(size_t size);
+
+/**
+ * @brief Frees memory allocated by magazine_allocate, putting size-class
+ * objects back in a magazine of the calling CPU. Does nothing if the pointer
+ * is NULL.
+ *
+ * @param ptr Pointer to memory to free.
+ */
+void magazine_free(void* ptr);
+
+/**
+ * @brief Resizes memory allocated by magazine_allocate, keeping it in place
+ * whenever slab_reallocate would.
+ *
+ * @param ptr Pointer to memory to resize. If NULL, this behaves like
+ * magazine_allocate.
+ * @param size New size, in bytes. If 0, the memory is freed and NULL is
+ * returned.
+ *
+ * @return Pointer to the resized memory, or NULL if the request cannot be
+ * satisfied, in which case the original memory is unchanged.
+ */
+void* magazine_reallocate(void* ptr, size_t size);
+
+/**
+ * @brief Returns every object and magazine held by the depot to the slab
+ * allocator. Magazines loaded on CPUs are kept. Called automatically when
+ * the slab allocator runs out of memory.
+ */
+void magazine_reclaim(void);
+
+/**
+ * @brief Counts the free objects of a size class held in magazines, on
+ * every CPU and in the depot. The slab allocator counts these as allocated.
+ *
+ * @param index Size class, less than SLAB_CACHE_COUNT.
+ *
+ * @return Number of cached objects.
+ */
+size_t magazine_get_cached_count(size_t index);
+
+#endif /* MAGAZINE_H_INCLUDED */
@@ -0,0 +1,120 @@
+/*
+ * memory_statistics.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <stdlib.h>
+
+#include <globals.h>
+#include <boot/kernel/memory/demand_zero.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/magazine.h>
+#include <boot/kernel/memory/memory_statistics.h>
+#include <boot/kernel/memory/slab.h>
+#include <boot/kernel/memory/vmalloc.h>
+#include <boot/kernel/memory/zero_pool.h>
+#include <boot/ui/terminal.h>
+
+/**
+ * @brief Writes a label followed by a decimal number.
+ *
+ * @param label Label to write before the number.
+ * @param value Number to write.
+ */
+static void write_field(const char* label, size_t value);
+
+void memory_statistics_dump(void)
+{
+    terminal_write_string("\nMemory statistics\n");
+
+    write_field("Frames: ", frame_allocator_get_frame_count());
+    write_field(", free ", frame_allocator_get_free_count());
+    write_field(", largest free run ", frame_allocator_get_largest_run());
+    write_field(", fragmentation % ", memory_statistics_get_fragmentation());
+
+    terminal_write_string("\nFree blocks by order:");
+    for (size_t order = 0; order <= FRAME_ALLOCATOR_MAX_ORDER; ++order)
+    {
+        write_field(" ", frame_allocator_get_block_count(order));
+    }
+    terminal_write_string("\n");
+
+    for (size_t index = 0; index < SLAB_CACHE_COUNT; ++index)
+    {
+        Slab_Statistics statistics;
+        size_t cached = magazine_get_cached_count(index);
+
+        slab_get_statistics(index, &statistics);
+
+        /* Objects sitting in magazines are free as far as callers are
+         * concerned, so they are not counted as in use. */
+        write_field("Class ", statistics.object_size);
+        write_field(": used ", statistics.allocated - cached);
+        write_field(", cached ", cached);
+        write_field(", free ", statistics.free);
+        write_field(", slabs ", statistics.slabs);
+        write_field(", peak ", statistics.peak);
+        terminal_write_string("\n");
+    }
+
+    Slab_Statistics large;
+
+    slab_get_large_statistics(&large);
+    write_field("Large blocks: ", large.allocated);
+    write_field(", frames ", large.frames);
+    write_field(", peak frames ", large.peak);
+
+    terminal_write_string("\nZero pool by order:");
+    for (size_t order = 0; order <= ZERO_POOL_MAX_ORDER; ++order)
+    {
+        write_field(" ", zero_pool_get_count(order));
+    }
+
+    write_field(
+        "\nDemand-zero resident frames: ",
+        demand_zero_get_resident_count());
+    write_field(
+        "\nVmalloc resident frames: ",
+        vmalloc_get_resident_count());
+    terminal_write_string("\n");
+}
+
+size_t memory_statistics_get_fragmentation(void)
+{
+    size_t free = frame_allocator_get_free_count();
+
+    if (free == 0)
+    {
+        return (0);
+    }
+
+    return (((free - frame_allocator_get_largest_run()) * 100) / free);
+}
+
+static void write_field(const char* label, size_t value)
+{
+    char str[33];
+
+    terminal_write_string(label);
+    terminal_write_string(sitoa(value, str, 10));
+}
@@ -0,0 +1,46 @@
+/*
+ * memory_statistics.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef MEMORY_STATISTICS_H_INCLUDED
+#define MEMORY_STATISTICS_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Writes the counters of every allocator layer to the terminal:
+ * frame allocator free blocks per order and largest free run, per size
+ * class objects in use, free, cached in magazines, slabs and peak, large
+ * blocks, the zero pool and demand-zero regions.
+ */
+void memory_statistics_dump(void);
+
+/**
+ * @brief Computes external fragmentation of free physical memory: the share
+ * of free frames that are not part of the longest free run.
+ *
+ * @return Fragmentation in percent, from 0 (all free memory is contiguous)
+ * to nearly 100.
+ */
+size_t memory_statistics_get_fragmentation(void);
+
+#endif /* MEMORY_STATISTICS_H_INCLUDED */
@@ -0,0 +1,351 @@
+/*
+ * paging.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string.h>
+
+#include <globals.h>
+#include <boot/cpu.h>
+#include <boot/memory.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/paging.h>
+
+/**
+ * @brief Number of entries in a page directory or page table.
+ */
+#define PAGING_ENTRY_COUNT 1024
+
+/**
+ * @brief Mask selecting the address bits of a page table entry.
+ */
+#define PAGING_ADDRESS_MASK 0xFFFFF000
+
+/**
+ * @brief Mask selecting the address bits of a large page directory entry.
+ */
+#define PAGING_LARGE_ADDRESS_MASK 0xFFC00000
+
+/**
+ * @brief CR0 bit enabling paging.
+ */
+#define CR0_PG 0x80000000
+
+/**
+ * @brief CR0 bit making the kernel honour read-only pages.
+ */
+#define CR0_WP 0x00010000
+
+/**
+ * @brief CR4 bit enabling 4 MiB pages.
+ */
+#define CR4_PSE 0x00000010
+
+/**
+ * @brief CR4 bit enabling global pages.
+ */
+#define CR4_PGE 0x00000080
+
+/**
+ * @brief Maps a whole region, using 4 MiB pages where possible.
+ *
+ * @param virtual Virtual address of the region, aligned to
+ * PAGING_LARGE_PAGE_SIZE.
+ * @param physical Physical address of the region, aligned to
+ * PAGING_LARGE_PAGE_SIZE.
+ * @param size Size of the region, a multiple of PAGING_LARGE_PAGE_SIZE.
+ * @param flags PAGING_* flags.
+ */
+static void map_region(
+    uintptr_t virtual,
+    uintptr_t physical,
+    size_t size,
+    uint32_t flags);
+
+/**
+ * @brief Gets a usable pointer to a page table. Page tables are reached
+ * through their physical address until paging is on, and through the direct
+ * map after.
+ *
+ * @param physical Physical address of the page table.
+ *
+ * @return Pointer to the page table.
+ */
+static inline uint32_t* get_table(uintptr_t physical);
+
+/**
+ * @brief Kernel page directory. It lives in the kernel image, which is
+ * identity mapped, so its address is also its physical address.
+ */
+static uint32_t page_directory[PAGING_ENTRY_COUNT]
+    __attribute__((aligned(PAGING_PAGE_SIZE)));
+
+/**
+ * @brief Whether paging has been enabled.
+ */
+static bool paging_enabled;
+
+/**
+ * @brief Whether the CPU supports 4 MiB pages.
+ */
+static bool large_pages;
+
+/**
+ * @brief PAGING_GLOBAL if the CPU supports global pages, 0 otherwise. Kernel
+ * mappings carry it so that they survive CR3 reloads.
+ */
+static uint32_t global_flag;
+
+void paging_initialize(void)
+{
+    if (cpu_has_cpuid())
+    {
+        uint32_t eax;
+        uint32_t ebx;
+        uint32_t ecx;
+        uint32_t edx;
+
+        cpu_cpuid(1, &eax, &ebx, &ecx, &edx);
+
+        large_pages = (edx & CPU_FEATURE_PSE) != 0;
+        global_flag = ((edx & CPU_FEATURE_PGE) != 0) ? PAGING_GLOBAL : 0;
+    }
+
+    uint32_t cr4 = cpu_read_cr4();
+
+    if (large_pages)
+    {
+        cr4 |= CR4_PSE;
+    }
+    if (global_flag != 0)
+    {
+        cr4 |= CR4_PGE;
+    }
+
+    cpu_write_cr4(cr4);
+
+    uint32_t flags = PAGING_WRITABLE | global_flag;
+
+    /* The kernel keeps running at its load address, so everything below
+     * memory_location (the kernel image, its stack and the frame
+     * bookkeeping) is identity mapped. */
+    size_t low_size = ((uintptr_t) memory_location
+        + PAGING_LARGE_PAGE_SIZE - 1) & PAGING_LARGE_ADDRESS_MASK;
+
+    map_region(0, 0, low_size, flags);
+
+    /* Every frame the frame allocator hands out is reachable through the
+     * direct map, so the kernel never needs a temporary mapping to touch
+     * physical memory. */
+    uint64_t direct_size = ((uint64_t) frame_allocator_get_frame_count()
+        << FRAME_ALLOCATOR_FRAME_SHIFT) + PAGING_LARGE_PAGE_SIZE - 1;
+
+    direct_size &= PAGING_LARGE_ADDRESS_MASK;
+    if (direct_size > PAGING_DIRECT_MAP_SIZE)
+    {
+        direct_size = PAGING_DIRECT_MAP_SIZE;
+    }
+
+    map_region(PAGING_DIRECT_MAP_BASE, 0, (size_t) direct_size, flags);
+
+    cpu_write_cr3((uint32_t) (uintptr_t) page_directory);
+    cpu_write_cr0(cpu_read_cr0() | CR0_PG | CR0_WP);
+
+    paging_enabled = true;
+}
+
+bool paging_map(uintptr_t virtual, uintptr_t physical, uint32_t flags)
+{
+    uint32_t* entry = &page_directory[virtual >> 22];
+
+    if (UNLIKELY((*entry & PAGING_LARGE) != 0))
+    {
+        return (false);
+    }
+
+    if ((*entry & PAGING_PRESENT) == 0)
+    {
+        uintptr_t table = frame_allocator_allocate(0);
+
+        if (table == 0)
+        {
+            return (false);
+        }
+
+        memset(get_table(table), 0, PAGING_PAGE_SIZE);
+
+        /* Access rights are decided by the page table entries. */
+        *entry = table | PAGING_PRESENT | PAGING_WRITABLE | PAGING_USER;
+    }
+
+    uint32_t* table = get_table(*entry & PAGING_ADDRESS_MASK);
+
+    table[(virtual >> 12) & (PAGING_ENTRY_COUNT - 1)] =
+        (physical & PAGING_ADDRESS_MASK) | flags | PAGING_PRESENT;
+
+    if (paging_enabled)
+    {
+        cpu_invalidate_page(virtual);
+    }
+
+    return (true);
+}
+
+bool paging_map_large(uintptr_t virtual, uintptr_t physical, uint32_t flags)
+{
+    uint32_t* entry = &page_directory[virtual >> 22];
+
+    if (UNLIKELY(!large_pages
+        || (*entry & (PAGING_PRESENT | PAGING_LARGE)) == PAGING_PRESENT))
+    {
+        return (false);
+    }
+
+    *entry = (physical & PAGING_LARGE_ADDRESS_MASK) | flags | PAGING_PRESENT
+        | PAGING_LARGE;
+
+    if (paging_enabled)
+    {
+        cpu_invalidate_page(virtual);
+    }
+
+    return (true);
+}
+
+bool paging_unmap(uintptr_t virtual)
+{
+    if (!paging_unmap_deferred(virtual))
+    {
+        return (false);
+    }
+
+    cpu_invalidate_page(virtual);
+
+    return (true);
+}
+
+bool paging_unmap_deferred(uintptr_t virtual)
+{
+    uint32_t* entry = &page_directory[virtual >> 22];
+
+    if ((*entry & PAGING_PRESENT) == 0)
+    {
+        return (false);
+    }
+
+    if ((*entry & PAGING_LARGE) != 0)
+    {
+        *entry = 0;
+        return (true);
+    }
+
+    uint32_t* table = get_table(*entry & PAGING_ADDRESS_MASK);
+    uint32_t* page = &table[(virtual >> 12) & (PAGING_ENTRY_COUNT - 1)];
+
+    if ((*page & PAGING_PRESENT) == 0)
+    {
+        return (false);
+    }
+
+    *page = 0;
+
+    return (true);
+}
+
+bool paging_get_physical(uintptr_t virtual, uintptr_t* physical)
+{
+    uint32_t entry = page_directory[virtual >> 22];
+
+    if ((entry & PAGING_PRESENT) == 0)
+    {
+        return (false);
+    }
+
+    if ((entry & PAGING_LARGE) != 0)
+    {
+        *physical = (entry & PAGING_LARGE_ADDRESS_MASK)
+            | (virtual & ~PAGING_LARGE_ADDRESS_MASK);
+        return (true);
+    }
+
+    uint32_t page = get_table(entry & PAGING_ADDRESS_MASK)
+        [(virtual >> 12) & (PAGING_ENTRY_COUNT - 1)];
+
+    if ((page & PAGING_PRESENT) == 0)
+    {
+        return (false);
+    }
+
+    *physical = (page & PAGING_ADDRESS_MASK) | (virtual & ~PAGING_ADDRESS_MASK);
+
+    return (true);
+}
+
+void paging_flush(void)
+{
+    cpu_write_cr3(cpu_read_cr3());
+}
+
+bool paging_has_large_pages(void)
+{
+    return (large_pages);
+}
+
+static void map_region(
+    uintptr_t virtual,
+    uintptr_t physical,
+    size_t size,
+    uint32_t flags)
+{
+    for (size_t offset = 0; offset < size; offset += PAGING_LARGE_PAGE_SIZE)
+    {
+        if (paging_map_large(virtual + offset, physical + offset, flags))
+        {
+            continue;
+        }
+
+        /* Without PSE the region takes one page table per 4 MiB. */
+        for (size_t page = 0;
+            page < PAGING_LARGE_PAGE_SIZE;
+            page += PAGING_PAGE_SIZE)
+        {
+            if (!paging_map(
+                virtual + offset + page,
+                physical + offset + page,
+                flags))
+            {
+                return;
+            }
+        }
+    }
+}
+
+static inline uint32_t* get_table(uintptr_t physical)
+{
+    if (LIKELY(paging_enabled))
+    {
+        return ((uint32_t*) PAGING_PHYSICAL_TO_VIRTUAL(physical));
+    }
+
+    return ((uint32_t*) physical);
+}
@@ -0,0 +1,152 @@
+/*
+ * paging.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef PAGING_H_INCLUDED
+#define PAGING_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Size of a page, in bytes.
+ */
+#define PAGING_PAGE_SIZE 4096
+
+/**
+ * @brief Size of a large (PSE) page, in bytes. Each page directory entry
+ * maps this much.
+ */
+#define PAGING_LARGE_PAGE_SIZE 0x400000
+
+/**
+ * @brief Virtual address physical memory is mapped at in the higher half.
+ */
+#define PAGING_DIRECT_MAP_BASE 0xC0000000
+
+/**
+ * @brief Largest amount of physical memory the direct map covers. The
+ * rest of the higher half is left for other kernel mappings.
+ */
+#define PAGING_DIRECT_MAP_SIZE 0x30000000
+
+/* Page directory and page table entry flags. */
+#define PAGING_PRESENT 0x001
+#define PAGING_WRITABLE 0x002
+#define PAGING_USER 0x004
+#define PAGING_WRITE_THROUGH 0x008
+#define PAGING_CACHE_DISABLE 0x010
+#define PAGING_ACCESSED 0x020
+#define PAGING_DIRTY 0x040
+#define PAGING_LARGE 0x080
+#define PAGING_GLOBAL 0x100
+
+/**
+ * @brief Converts a physical address to its address in the direct map.
+ *
+ * @param x Physical address below PAGING_DIRECT_MAP_SIZE.
+ */
+#define PAGING_PHYSICAL_TO_VIRTUAL(x) \
+    ((void*) ((uintptr_t) (x) + PAGING_DIRECT_MAP_BASE))
+
+/**
+ * @brief Converts an address in the direct map to its physical address.
+ *
+ * @param x Virtual address inside the direct map.
+ */
+#define PAGING_VIRTUAL_TO_PHYSICAL(x) \
+    ((uintptr_t) (x) - PAGING_DIRECT_MAP_BASE)
+
+/**
+ * @brief Builds the kernel page directory and enables paging. Low memory up
+ * to memory_location stays identity mapped, since the kernel runs there,
+ * and every frame the frame allocator manages is mapped at
+ * PAGING_DIRECT_MAP_BASE. Both use 4 MiB pages when the CPU supports PSE.
+ * The frame allocator must already be initialized.
+ */
+void paging_initialize(void);
+
+/**
+ * @brief Maps a 4 KiB page, allocating a page table if needed.
+ *
+ * @param virtual Page-aligned virtual address.
+ * @param physical Page-aligned physical address.
+ * @param flags PAGING_* flags. PAGING_PRESENT is implied.
+ *
+ * @return True if mapped, false if a page table could not be allocated or
+ * a large page already covers the address.
+ */
+bool paging_map(uintptr_t virtual, uintptr_t physical, uint32_t flags);
+
+/**
+ * @brief Maps a 4 MiB page.
+ *
+ * @param virtual Virtual address aligned to PAGING_LARGE_PAGE_SIZE.
+ * @param physical Physical address aligned to PAGING_LARGE_PAGE_SIZE.
+ * @param flags PAGING_* flags. PAGING_PRESENT and PAGING_LARGE are implied.
+ *
+ * @return True if mapped, false if large pages are not supported or a page
+ * table already covers the address.
+ */
+bool paging_map_large(uintptr_t virtual, uintptr_t physical, uint32_t flags);
+
+/**
+ * @brief Removes the mapping of a page, of either size, and its TLB entry.
+ *
+ * @param virtual Virtual address within the page.
+ *
+ * @return True if a mapping was removed.
+ */
+bool paging_unmap(uintptr_t virtual);
+
+/**
+ * @brief Removes the mapping of a page without flushing its TLB entry, so
+ * that several unmaps can share one flush.
+ *
+ * @param virtual Virtual address within the page.
+ *
+ * @return True if a mapping was removed.
+ */
+bool paging_unmap_deferred(uintptr_t virtual);
+
+/**
+ * @brief Looks up the physical address a virtual address is mapped to.
+ *
+ * @param virtual Virtual address.
+ * @param physical Location to store the physical address in.
+ *
+ * @return True if the address is mapped.
+ */
+bool paging_get_physical(uintptr_t virtual, uintptr_t* physical);
+
+/**
+ * @brief Flushes every non-global TLB entry.
+ */
+void paging_flush(void);
+
+/**
+ * @brief Checks whether 4 MiB pages are in use.
+ *
+ * @return True if the CPU supports PSE.
+ */
+bool paging_has_large_pages(void);
+
+#endif /* PAGING_H_INCLUDED */
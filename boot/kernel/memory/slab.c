@@ -0,0 +1,593 @@
+/*
+ * slab.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string.h>
+
+#include <globals.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/paging.h>
+#include <boot/kernel/memory/slab.h>
+#include <boot/kernel/memory/vmalloc.h>
+#include <boot/kernel/memory/zero_pool.h>
+
+/**
+ * @brief Order of the smallest large block.
+ */
+#define LARGE_MIN_ORDER 1
+
+/**
+ * @brief Header at the start of every slab.
+ */
+typedef struct Slab
+{
+    /* Neighbours in the partial list of the cache. */
+    struct Slab* next;
+    struct Slab* prev;
+
+    /* Cache the slab belongs to. */
+    struct Slab_Cache* cache;
+
+    /* Objects that have been freed back to the slab. */
+    void* free_list;
+
+    /* Next object that has never been handed out. Objects past this point
+     * are not on the free list, so a new slab is not walked to build one. */
+    uint8_t* unused;
+
+    /* Number of objects currently allocated from the slab. */
+    size_t in_use;
+} Slab;
+
+/**
+ * @brief Cache of slabs for one size class.
+ */
+typedef struct Slab_Cache
+{
+    /* Size of each object, in bytes. */
+    size_t object_size;
+
+    /* Frame allocator order of each slab. */
+    size_t order;
+
+    /* Number of objects held by each slab. */
+    size_t capacity;
+
+    /* Offset of the first object from the start of the slab. */
+    size_t offset;
+
+    /* Slabs with both allocated and free objects. Full slabs are not
+     * tracked until an object is freed back to them. */
+    Slab* partial;
+
+    /* A single completely free slab kept to absorb churn at the boundary
+     * between slabs. Further empty slabs are returned to the frame
+     * allocator. */
+    Slab* empty;
+
+    /* Number of slabs, including the empty one. */
+    size_t slab_count;
+
+    /* Number of objects allocated. */
+    size_t allocated;
+
+    /* Highest value allocated has reached. */
+    size_t peak;
+} Slab_Cache;
+
+/**
+ * @brief Allocates and sets up a new slab for a cache.
+ *
+ * @param cache Cache to create a slab for.
+ *
+ * @return New slab, or NULL if the frame allocator is exhausted.
+ */
+static Slab* slab_create(Slab_Cache* cache);
+
+/**
+ * @brief Returns a slab to the frame allocator.
+ *
+ * @param slab Slab to destroy. It must have no allocated objects.
+ */
+static void slab_destroy(Slab* slab);
+
+/**
+ * @brief Records a large block being handed out.
+ *
+ * @param order Order of the block.
+ */
+static void large_account(size_t order);
+
+/**
+ * @brief Moves memory to a new allocation by copying it, then frees the old
+ * memory.
+ *
+ * @param ptr Memory to move.
+ * @param old_size Usable size of ptr, in bytes.
+ * @param size Size of the new allocation, in bytes.
+ *
+ * @return New memory, or NULL if it could not be allocated, in which case
+ * ptr is unchanged.
+ */
+static void* move_block(void* ptr, size_t old_size, size_t size);
+
+/**
+ * @brief Links a slab at the head of the partial list of its cache.
+ *
+ * @param slab Slab to link.
+ */
+static void partial_push(Slab* slab);
+
+/**
+ * @brief Unlinks a slab from the partial list of its cache.
+ *
+ * @param slab Slab to unlink.
+ */
+static void partial_remove(Slab* slab);
+
+/**
+ * @brief Caches for every size class, smallest first.
+ */
+static Slab_Cache caches[SLAB_CACHE_COUNT];
+
+/**
+ * @brief Number of large blocks allocated.
+ */
+static size_t large_count;
+
+/**
+ * @brief Number of frames held by large blocks.
+ */
+static size_t large_frames;
+
+/**
+ * @brief Highest value large_frames has reached.
+ */
+static size_t large_peak;
+
+void slab_initialize(void)
+{
+    for (size_t i = 0; i < SLAB_CACHE_COUNT; ++i)
+    {
+        Slab_Cache* cache = &caches[i];
+
+        cache->object_size = SLAB_MIN_SIZE << i;
+        cache->order = frame_allocator_get_order(
+            cache->object_size * SLAB_MIN_OBJECTS);
+
+        /* The header takes up whole objects so that every object stays
+         * aligned to its size. */
+        cache->offset = (sizeof(Slab) + cache->object_size - 1)
+            & ~(cache->object_size - 1);
+        cache->capacity
+            = ((FRAME_ALLOCATOR_FRAME_SIZE << cache->order) - cache->offset)
+            / cache->object_size;
+
+        cache->partial = NULL;
+        cache->empty = NULL;
+        cache->slab_count = 0;
+        cache->allocated = 0;
+        cache->peak = 0;
+    }
+}
+
+void* slab_allocate(size_t size)
+{
+    /* Large allocations take whole blocks from the frame allocator. */
+    if (UNLIKELY(size > SLAB_MAX_SIZE))
+    {
+        size_t order = frame_allocator_get_order(size);
+        uintptr_t address = frame_allocator_allocate(order);
+
+        if (address == 0)
+        {
+            return (NULL);
+        }
+
+        large_account(order);
+
+        return (PAGING_PHYSICAL_TO_VIRTUAL(address));
+    }
+
+    Slab_Cache* cache = &caches[slab_get_size_class(size)];
+    Slab* slab = cache->partial;
+
+    if (UNLIKELY(slab == NULL))
+    {
+        slab = cache->empty;
+
+        if (slab != NULL)
+        {
+            cache->empty = NULL;
+        }
+        else
+        {
+            slab = slab_create(cache);
+
+            if (slab == NULL)
+            {
+                return (NULL);
+            }
+        }
+
+        partial_push(slab);
+    }
+
+    void* ret = slab->free_list;
+
+    if (ret != NULL)
+    {
+        slab->free_list = *((void**) ret);
+    }
+    else
+    {
+        ret = slab->unused;
+        slab->unused += cache->object_size;
+    }
+
+    ++slab->in_use;
+
+    if (++cache->allocated > cache->peak)
+    {
+        cache->peak = cache->allocated;
+    }
+
+    /* Full slabs leave the partial list until an object is freed. */
+    if (slab->in_use == cache->capacity)
+    {
+        partial_remove(slab);
+    }
+
+    return (ret);
+}
+
+void slab_free(void* ptr)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    /* Large blocks moved by realloc live in the vmalloc window. */
+    if (UNLIKELY(vmalloc_contains(ptr)))
+    {
+        --large_count;
+        vmalloc_free(ptr);
+        return;
+    }
+
+    uintptr_t address = PAGING_VIRTUAL_TO_PHYSICAL(ptr);
+    Frame* frame = frame_allocator_get_frame(address);
+
+    if (UNLIKELY((frame->flags & FRAME_SLAB) == 0))
+    {
+        --large_count;
+        large_frames -= (size_t) 1 << frame->order;
+        frame_allocator_free(address, frame->order);
+        return;
+    }
+
+    Slab* slab = (Slab*) frame->private;
+    Slab_Cache* cache = slab->cache;
+
+    *((void**) ptr) = slab->free_list;
+    slab->free_list = ptr;
+
+    if (slab->in_use == cache->capacity)
+    {
+        partial_push(slab);
+    }
+
+    --slab->in_use;
+    --cache->allocated;
+
+    if (UNLIKELY(slab->in_use == 0))
+    {
+        partial_remove(slab);
+
+        if (cache->empty == NULL)
+        {
+            cache->empty = slab;
+        }
+        else
+        {
+            slab_destroy(slab);
+        }
+    }
+}
+
+void* slab_reallocate(void* ptr, size_t size)
+{
+    if (ptr == NULL)
+    {
+        return (slab_allocate(size));
+    }
+
+    if (size == 0)
+    {
+        slab_free(ptr);
+        return (NULL);
+    }
+
+    /* Blocks in the vmalloc window resize by remapping their pages. Like
+     * other large blocks, they stay larger than any size class. */
+    if (vmalloc_contains(ptr))
+    {
+        size_t minimum = (size_t) FRAME_ALLOCATOR_FRAME_SIZE
+            << LARGE_MIN_ORDER;
+        void* ret = vmalloc_reallocate(ptr,
+            (size < minimum) ? minimum : size);
+
+        if (ret != NULL)
+        {
+            return (ret);
+        }
+
+        return (move_block(ptr, vmalloc_get_size(ptr), size));
+    }
+
+    uintptr_t address = PAGING_VIRTUAL_TO_PHYSICAL(ptr);
+    Frame* frame = frame_allocator_get_frame(address);
+    size_t old_size;
+
+    if ((frame->flags & FRAME_SLAB) != 0)
+    {
+        old_size = ((Slab*) frame->private)->cache->object_size;
+
+        /* Slack in the size class absorbs the growth. */
+        if (size <= old_size)
+        {
+            return (ptr);
+        }
+    }
+    else
+    {
+        size_t order = frame->order;
+        size_t new_order = frame_allocator_get_order(size);
+
+        /* Large blocks stay larger than any size class, so that their size
+         * alone tells them apart from slab objects. */
+        if (new_order < LARGE_MIN_ORDER)
+        {
+            new_order = LARGE_MIN_ORDER;
+        }
+
+        old_size = (size_t) FRAME_ALLOCATOR_FRAME_SIZE << order;
+
+        /* Large blocks give back their unused upper halves in place. */
+        if (new_order <= order)
+        {
+            if (new_order < order)
+            {
+                frame_allocator_shrink(address, order, new_order);
+                large_frames -= ((size_t) 1 << order)
+                    - ((size_t) 1 << new_order);
+            }
+            return (ptr);
+        }
+
+        if (frame_allocator_grow(address, order, new_order))
+        {
+            large_frames += ((size_t) 1 << new_order)
+                - ((size_t) 1 << order);
+            if (large_frames > large_peak)
+            {
+                large_peak = large_frames;
+            }
+            return (ptr);
+        }
+
+        /* Otherwise the frames are mapped into the vmalloc window, where
+         * the block can keep growing without a copy. From then on they are
+         * counted as vmalloc frames. */
+        void* ret = vmalloc_adopt(address, order, size);
+
+        if (ret != NULL)
+        {
+            large_frames -= (size_t) 1 << order;
+            return (ret);
+        }
+    }
+
+    return (move_block(ptr, old_size, size));
+}
+
+size_t slab_get_size(void* ptr)
+{
+    if (vmalloc_contains(ptr))
+    {
+        return (vmalloc_get_size(ptr));
+    }
+
+    Frame* frame = frame_allocator_get_frame(PAGING_VIRTUAL_TO_PHYSICAL(ptr));
+
+    if ((frame->flags & FRAME_SLAB) != 0)
+    {
+        return (((Slab*) frame->private)->cache->object_size);
+    }
+
+    return ((size_t) FRAME_ALLOCATOR_FRAME_SIZE << frame->order);
+}
+
+void* slab_allocate_zeroed(size_t size)
+{
+    /* Large blocks zeroed ahead of time by the idle loop need no work. */
+    if (size > SLAB_MAX_SIZE)
+    {
+        size_t order = frame_allocator_get_order(size);
+        uintptr_t address = zero_pool_allocate(order);
+
+        if (address != 0)
+        {
+            large_account(order);
+            return (PAGING_PHYSICAL_TO_VIRTUAL(address));
+        }
+    }
+
+    void* ret = slab_allocate(size);
+
+    if (ret == NULL)
+    {
+        return (NULL);
+    }
+
+    return (memset(ret, 0, size));
+}
+
+void slab_get_statistics(size_t index, Slab_Statistics* statistics)
+{
+    Slab_Cache* cache = &caches[index];
+
+    statistics->object_size = cache->object_size;
+    statistics->allocated = cache->allocated;
+    statistics->free = (cache->slab_count * cache->capacity)
+        - cache->allocated;
+    statistics->slabs = cache->slab_count;
+    statistics->frames = cache->slab_count << cache->order;
+    statistics->peak = cache->peak;
+}
+
+void slab_get_large_statistics(Slab_Statistics* statistics)
+{
+    statistics->object_size = 0;
+    statistics->allocated = large_count;
+    statistics->free = 0;
+    statistics->slabs = 0;
+    statistics->frames = large_frames;
+    statistics->peak = large_peak;
+}
+
+static Slab* slab_create(Slab_Cache* cache)
+{
+    uintptr_t address = frame_allocator_allocate(cache->order);
+
+    if (address == 0)
+    {
+        return (NULL);
+    }
+
+    Slab* slab = PAGING_PHYSICAL_TO_VIRTUAL(address);
+
+    slab->next = NULL;
+    slab->prev = NULL;
+    slab->cache = cache;
+    slab->free_list = NULL;
+    slab->unused = (uint8_t*) slab + cache->offset;
+    slab->in_use = 0;
+
+    ++cache->slab_count;
+
+    /* Every frame of the slab leads back to the header, so that any object
+     * can find its slab. */
+    for (size_t i = 0; i < ((size_t) 1 << cache->order); ++i)
+    {
+        Frame* frame = frame_allocator_get_frame(
+            address + (i * FRAME_ALLOCATOR_FRAME_SIZE));
+
+        frame->flags |= FRAME_SLAB;
+        frame->private = (uint32_t) slab;
+    }
+
+    return (slab);
+}
+
+static void slab_destroy(Slab* slab)
+{
+    uintptr_t address = PAGING_VIRTUAL_TO_PHYSICAL(slab);
+    size_t order = slab->cache->order;
+
+    --slab->cache->slab_count;
+
+    for (size_t i = 0; i < ((size_t) 1 << order); ++i)
+    {
+        Frame* frame = frame_allocator_get_frame(
+            address + (i * FRAME_ALLOCATOR_FRAME_SIZE));
+
+        frame->flags &= ~FRAME_SLAB;
+        frame->private = 0;
+    }
+
+    frame_allocator_free(address, order);
+}
+
+static void large_account(size_t order)
+{
+    ++large_count;
+    large_frames += (size_t) 1 << order;
+
+    if (large_frames > large_peak)
+    {
+        large_peak = large_frames;
+    }
+}
+
+static void* move_block(void* ptr, size_t old_size, size_t size)
+{
+    void* ret = slab_allocate(size);
+
+    if (ret == NULL)
+    {
+        return (NULL);
+    }
+
+    memcpy(ret, ptr, (old_size < size) ? old_size : size);
+    slab_free(ptr);
+
+    return (ret);
+}
+
+static void partial_push(Slab* slab)
+{
+    Slab_Cache* cache = slab->cache;
+
+    slab->prev = NULL;
+    slab->next = cache->partial;
+
+    if (slab->next != NULL)
+    {
+        slab->next->prev = slab;
+    }
+
+    cache->partial = slab;
+}
+
+static void partial_remove(Slab* slab)
+{
+    if (slab->prev != NULL)
+    {
+        slab->prev->next = slab->next;
+    }
+    else
+    {
+        slab->cache->partial = slab->next;
+    }
+
+    if (slab->next != NULL)
+    {
+        slab->next->prev = slab->prev;
+    }
+
+    slab->next = NULL;
+    slab->prev = NULL;
+}
@@ -0,0 +1,178 @@
+/*
+ * slab.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef SLAB_H_INCLUDED
+#define SLAB_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Size of the smallest size class, in bytes.
+ */
+#define SLAB_MIN_SIZE 8
+
+/**
+ * @brief Size of the largest size class, in bytes. Larger allocations are
+ * served directly by the frame allocator.
+ */
+#define SLAB_MAX_SIZE 4096
+
+/**
+ * @brief Number of power-of-two size classes from SLAB_MIN_SIZE to
+ * SLAB_MAX_SIZE.
+ */
+#define SLAB_CACHE_COUNT 10
+
+/**
+ * @brief Minimum number of objects held by a slab. Slabs of large size
+ * classes span several frames to meet this.
+ */
+#define SLAB_MIN_OBJECTS 8
+
+/**
+ * @brief Counters of one size class, or of the large blocks served directly
+ * by the frame allocator.
+ */
+typedef struct Slab_Statistics
+{
+    /* Size of each object, in bytes, or 0 for large blocks. */
+    size_t object_size;
+
+    /* Number of objects or large blocks allocated. Objects cached in
+     * magazines count as allocated here. */
+    size_t allocated;
+
+    /* Number of free objects in the slabs of the class. */
+    size_t free;
+
+    /* Number of slabs, including the cached empty one. */
+    size_t slabs;
+
+    /* Number of frames held. */
+    size_t frames;
+
+    /* Highest number of objects allocated at once, or, for large blocks,
+     * highest number of frames held at once. */
+    size_t peak;
+} Slab_Statistics;
+
+/**
+ * @brief Sets up the size class caches. The frame allocator must already be
+ * initialized.
+ */
+void slab_initialize(void);
+
+/**
+ * @brief Allocates memory from the size class that fits a given size, or
+ * directly from the frame allocator if no size class does.
+ *
+ * @param size Size of memory to allocate, in bytes.
+ *
+ * @return Pointer to allocated memory, aligned to the size class (or to a
+ * frame for large allocations). Returns NULL if the request cannot be
+ * satisfied.
+ */
+void* slab_allocate(size_t size);
+
+/**
+ * @brief Frees memory allocated by slab_allocate. Does nothing if the
+ * pointer is NULL.
+ *
+ * @param ptr Pointer to memory to free.
+ */
+void slab_free(void* ptr);
+
+/**
+ * @brief Resizes memory allocated by slab_allocate. Memory stays where it is
+ * when the new size fits its size class, or when a large block can absorb
+ * the free buddies that follow it. A large block that cannot grow in place
+ * moves to the vmalloc window by having its frames mapped there, and grows
+ * there by remapping, so that its contents are never copied. Slab objects,
+ * and large blocks when the window is full, are moved by copying.
+ *
+ * @param ptr Pointer to memory to resize. If NULL, this behaves like
+ * slab_allocate.
+ * @param size New size, in bytes. If 0, the memory is freed and NULL is
+ * returned.
+ *
+ * @return Pointer to the resized memory, or NULL if the request cannot be
+ * satisfied, in which case the original memory is unchanged.
+ */
+void* slab_reallocate(void* ptr, size_t size);
+
+/**
+ * @brief Gets the number of usable bytes of memory allocated by
+ * slab_allocate, which may be more than was requested.
+ *
+ * @param ptr Pointer to allocated memory.
+ *
+ * @return Size of the size class or block holding the memory, in bytes.
+ */
+size_t slab_get_size(void* ptr);
+
+/**
+ * @brief Allocates zeroed memory like slab_allocate. Large blocks are taken
+ * from the zero pool when it has one of the right order.
+ *
+ * @param size Size of memory to allocate, in bytes.
+ *
+ * @return Pointer to zeroed memory, or NULL if the request cannot be
+ * satisfied.
+ */
+void* slab_allocate_zeroed(size_t size);
+
+/**
+ * @brief Reads the counters of a size class.
+ *
+ * @param index Size class, less than SLAB_CACHE_COUNT.
+ * @param statistics Location to store the counters in.
+ */
+void slab_get_statistics(size_t index, Slab_Statistics* statistics);
+
+/**
+ * @brief Reads the counters of the large blocks.
+ *
+ * @param statistics Location to store the counters in.
+ */
+void slab_get_large_statistics(Slab_Statistics* statistics);
+
+/**
+ * @brief Finds the size class for a given size.
+ *
+ * @param size Size in bytes. Must not exceed SLAB_MAX_SIZE.
+ *
+ * @return Index of the smallest size class that holds the size. Class i
+ * holds objects of SLAB_MIN_SIZE << i bytes.
+ */
+static inline size_t slab_get_size_class(size_t size)
+{
+    if (size <= SLAB_MIN_SIZE)
+    {
+        return (0);
+    }
+
+    /* Rounds up to the next power of two, counted from SLAB_MIN_SIZE. */
+    return ((sizeof(unsigned int) * 8) - __builtin_clz(size - 1) - 3);
+}
+
+#endif /* SLAB_H_INCLUDED */
@@ -0,0 +1,433 @@
+/*
+ * vmalloc.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string.h>
+
+#include <globals.h>
+#include <boot/kernel/interrupts/page_fault.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/paging.h>
+#include <boot/kernel/memory/vmalloc.h>
+
+/**
+ * @brief Range of the vmalloc window taken by a buffer.
+ */
+typedef struct Vmalloc_Region
+{
+    /* Page-aligned start of the buffer. */
+    uintptr_t base;
+
+    /* Size of the buffer in bytes, excluding its guard page. */
+    size_t size;
+
+    /* True once the buffer has been freed. The range stays reserved until
+     * the next purge, since the TLB may still hold its old entries. */
+    bool freed;
+} Vmalloc_Region;
+
+/**
+ * @brief Finds a gap in the window and records a region there.
+ *
+ * @param size Size of the region in bytes, a multiple of the page size.
+ *
+ * @return Start of the region, or 0 if no gap is large enough or the region
+ * table is full.
+ */
+static uintptr_t reserve(size_t size);
+
+/**
+ * @brief Flushes the TLB once and releases the ranges of every freed
+ * region.
+ */
+static void purge(void);
+
+/**
+ * @brief Marks a region freed, leaving its range reserved until the next
+ * purge. The region must not be used afterwards, since a purge may move
+ * the region table.
+ *
+ * @param region Region whose pages have all been unmapped.
+ */
+static void retire(Vmalloc_Region* region);
+
+/**
+ * @brief Unmaps the pages of a range and frees the frames behind them.
+ *
+ * @param start Page-aligned start of the range.
+ * @param end Page-aligned end of the range.
+ * @param deferred Whether to leave the TLB flush to the next purge, which
+ * is only safe for a range that is not used again before then.
+ */
+static void release_pages(uintptr_t start, uintptr_t end, bool deferred);
+
+/**
+ * @brief Finds the region containing an address.
+ *
+ * @param address Virtual address.
+ *
+ * @return Region containing the address, or NULL if there is none.
+ */
+static Vmalloc_Region* find_region(uintptr_t address);
+
+/**
+ * @brief Regions currently reserved, sorted by base address.
+ */
+static Vmalloc_Region regions[VMALLOC_REGION_COUNT];
+
+/**
+ * @brief Number of regions currently reserved.
+ */
+static size_t region_count;
+
+/**
+ * @brief Number of pages in freed regions awaiting a purge.
+ */
+static size_t lazy_count;
+
+/**
+ * @brief Number of frames currently backing regions.
+ */
+static size_t resident_count;
+
+void* vmalloc_allocate(size_t size)
+{
+    if (UNLIKELY(size == 0 || size > VMALLOC_END - VMALLOC_BASE))
+    {
+        return (NULL);
+    }
+
+    size = (size + PAGING_PAGE_SIZE - 1) & ~(PAGING_PAGE_SIZE - 1);
+
+    uintptr_t base = reserve(size);
+
+    /* Freed ranges may be all that stands in the way. */
+    if (base == 0 && lazy_count != 0)
+    {
+        purge();
+        base = reserve(size);
+    }
+
+    return ((void*) base);
+}
+
+void vmalloc_free(void* ptr)
+{
+    Vmalloc_Region* region = find_region((uintptr_t) ptr);
+
+    if (UNLIKELY(region == NULL || region->freed
+        || region->base != (uintptr_t) ptr))
+    {
+        return;
+    }
+
+    /* Only the page table entries are cleared here; the frames can be
+     * reused at once, since nothing may touch a freed buffer. */
+    release_pages(region->base, region->base + region->size, true);
+    retire(region);
+}
+
+void* vmalloc_adopt(uintptr_t physical, size_t order, size_t size)
+{
+    size_t block_size = (size_t) PAGING_PAGE_SIZE << order;
+    uintptr_t base = (uintptr_t) vmalloc_allocate(
+        (size > block_size) ? size : block_size);
+
+    if (base == 0)
+    {
+        return (NULL);
+    }
+
+    for (size_t offset = 0; offset < block_size; offset += PAGING_PAGE_SIZE)
+    {
+        if (UNLIKELY(!paging_map(
+            base + offset,
+            physical + offset,
+            PAGING_PRESENT | PAGING_WRITABLE)))
+        {
+            /* The block still belongs to the caller, so only the mappings
+             * are undone. */
+            for (size_t undo = 0; undo < offset; undo += PAGING_PAGE_SIZE)
+            {
+                paging_unmap_deferred(base + undo);
+            }
+            retire(find_region(base));
+            return (NULL);
+        }
+    }
+
+    resident_count += (size_t) 1 << order;
+
+    return ((void*) base);
+}
+
+void* vmalloc_reallocate(void* ptr, size_t size)
+{
+    Vmalloc_Region* region = find_region((uintptr_t) ptr);
+
+    if (UNLIKELY(region == NULL || region->freed
+        || region->base != (uintptr_t) ptr
+        || size == 0 || size > VMALLOC_END - VMALLOC_BASE))
+    {
+        return (NULL);
+    }
+
+    size = (size + PAGING_PAGE_SIZE - 1) & ~(PAGING_PAGE_SIZE - 1);
+
+    /* The tail is flushed at once, since the buffer may grow back over
+     * it. */
+    if (size <= region->size)
+    {
+        release_pages(region->base + size, region->base + region->size,
+            false);
+        region->size = size;
+        return (ptr);
+    }
+
+    /* Grows in place if the gap after the buffer still leaves a guard
+     * page. Freed regions awaiting a purge count as taken. */
+    size_t index = (size_t) (region - regions);
+    uintptr_t limit = (index + 1 < region_count) ? regions[index + 1].base
+        : VMALLOC_END;
+
+    if (limit - region->base >= size + PAGING_PAGE_SIZE)
+    {
+        region->size = size;
+        return (ptr);
+    }
+
+    uintptr_t base = (uintptr_t) vmalloc_allocate(size);
+
+    if (base == 0)
+    {
+        return (NULL);
+    }
+
+    /* Reserving may have moved the region table. */
+    region = find_region((uintptr_t) ptr);
+
+    /* Every page is mapped at its new address before any is unmapped from
+     * the old one, so that a failure leaves the buffer untouched. */
+    for (size_t offset = 0; offset < region->size; offset += PAGING_PAGE_SIZE)
+    {
+        uintptr_t physical;
+
+        if (paging_get_physical(region->base + offset, &physical)
+            && UNLIKELY(!paging_map(
+                base + offset,
+                physical,
+                PAGING_PRESENT | PAGING_WRITABLE)))
+        {
+            for (size_t undo = 0; undo < offset; undo += PAGING_PAGE_SIZE)
+            {
+                paging_unmap_deferred(base + undo);
+            }
+            retire(find_region(base));
+            return (NULL);
+        }
+    }
+
+    for (size_t offset = 0; offset < region->size; offset += PAGING_PAGE_SIZE)
+    {
+        paging_unmap_deferred(region->base + offset);
+    }
+    retire(region);
+
+    return ((void*) base);
+}
+
+size_t vmalloc_get_size(void* ptr)
+{
+    Vmalloc_Region* region = find_region((uintptr_t) ptr);
+
+    if (region == NULL || region->freed || region->base != (uintptr_t) ptr)
+    {
+        return (0);
+    }
+
+    return (region->size);
+}
+
+bool vmalloc_handle_fault(uintptr_t address, uint32_t error)
+{
+    if ((error & (PAGE_FAULT_PRESENT | PAGE_FAULT_RESERVED)) != 0)
+    {
+        return (false);
+    }
+
+    Vmalloc_Region* region = find_region(address);
+
+    if (region == NULL || region->freed)
+    {
+        return (false);
+    }
+
+    uintptr_t frame = frame_allocator_allocate(0);
+
+    if (UNLIKELY(frame == 0))
+    {
+        return (false);
+    }
+
+    if (UNLIKELY(!paging_map(
+        address & ~(PAGING_PAGE_SIZE - 1),
+        frame,
+        PAGING_PRESENT | PAGING_WRITABLE)))
+    {
+        frame_allocator_free(frame, 0);
+        return (false);
+    }
+
+    ++resident_count;
+
+    return (true);
+}
+
+size_t vmalloc_get_resident_count(void)
+{
+    return (resident_count);
+}
+
+static uintptr_t reserve(size_t size)
+{
+    if (region_count == VMALLOC_REGION_COUNT)
+    {
+        return (0);
+    }
+
+    /* First fit over the gaps between regions, each of which keeps one
+     * guard page after it. */
+    uintptr_t base = VMALLOC_BASE;
+    size_t index = 0;
+
+    while (index < region_count)
+    {
+        if (regions[index].base - base >= size + PAGING_PAGE_SIZE)
+        {
+            break;
+        }
+
+        base = regions[index].base + regions[index].size + PAGING_PAGE_SIZE;
+        ++index;
+    }
+
+    if (VMALLOC_END - base < size + PAGING_PAGE_SIZE)
+    {
+        return (0);
+    }
+
+    memmove(
+        &regions[index + 1],
+        &regions[index],
+        (region_count - index) * sizeof(Vmalloc_Region));
+
+    regions[index].base = base;
+    regions[index].size = size;
+    regions[index].freed = false;
+    ++region_count;
+
+    return (base);
+}
+
+static void purge(void)
+{
+    /* Buffer pages are never global, so one reload drops them all. */
+    paging_flush();
+
+    size_t kept = 0;
+
+    for (size_t i = 0; i < region_count; ++i)
+    {
+        if (!regions[i].freed)
+        {
+            regions[kept] = regions[i];
+            ++kept;
+        }
+    }
+
+    region_count = kept;
+    lazy_count = 0;
+}
+
+static void retire(Vmalloc_Region* region)
+{
+    region->freed = true;
+    lazy_count += region->size / PAGING_PAGE_SIZE;
+
+    if (lazy_count >= VMALLOC_LAZY_PAGES)
+    {
+        purge();
+    }
+}
+
+static void release_pages(uintptr_t start, uintptr_t end, bool deferred)
+{
+    for (uintptr_t page = start; page < end; page += PAGING_PAGE_SIZE)
+    {
+        uintptr_t physical;
+
+        if (!paging_get_physical(page, &physical))
+        {
+            continue;
+        }
+
+        if (deferred)
+        {
+            paging_unmap_deferred(page);
+        }
+        else
+        {
+            paging_unmap(page);
+        }
+        frame_allocator_free(physical, 0);
+        --resident_count;
+    }
+}
+
+static Vmalloc_Region* find_region(uintptr_t address)
+{
+    size_t low = 0;
+    size_t high = region_count;
+
+    while (low < high)
+    {
+        size_t middle = (low + high) / 2;
+        Vmalloc_Region* region = &regions[middle];
+
+        if (address < region->base)
+        {
+            high = middle;
+        }
+        else if (address - region->base >= region->size)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            return (region);
+        }
+    }
+
+    return (NULL);
+}
@@ -0,0 +1,150 @@
+/*
+ * vmalloc.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef VMALLOC_H_INCLUDED
+#define VMALLOC_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Start of the virtual window vmalloc buffers are placed in, just
+ * above the direct map.
+ */
+#define VMALLOC_BASE 0xF0000000
+
+/**
+ * @brief End of the virtual window vmalloc buffers are placed in.
+ */
+#define VMALLOC_END 0xFFC00000
+
+/**
+ * @brief Largest number of buffers, live or awaiting a purge, that can
+ * exist at once.
+ */
+#define VMALLOC_REGION_COUNT 64
+
+/**
+ * @brief Number of freed pages after which freed ranges are purged. Until
+ * then their virtual addresses are not reused, so that the TLB is flushed
+ * once per batch of frees rather than once per free.
+ */
+#define VMALLOC_LAZY_PAGES 4096
+
+/**
+ * @brief Allocates a buffer that is contiguous in kernel virtual memory but
+ * backed by frames from anywhere in physical memory, so that it does not
+ * depend on finding a physically contiguous run. Pages are backed when
+ * first touched, and their contents are unspecified, as with malloc. Each
+ * buffer is followed by an unmapped guard page.
+ *
+ * @param size Size of the buffer, in bytes. Rounded up to whole pages.
+ *
+ * @return Page-aligned start of the buffer, or NULL if the window or the
+ * region table is full.
+ */
+void* vmalloc_allocate(size_t size);
+
+/**
+ * @brief Frees a buffer, returning every frame that backs it at once. The
+ * TLB entries of the buffer are dropped lazily, together with those of
+ * other freed buffers, before its addresses are handed out again.
+ *
+ * @param ptr Start of the buffer, as returned by vmalloc_allocate. Does
+ * nothing if NULL.
+ */
+void vmalloc_free(void* ptr);
+
+/**
+ * @brief Moves a block of physically contiguous frames into a new buffer
+ * without copying it. The frames are mapped at the start of the buffer,
+ * and the rest of the buffer is backed when first touched. The buffer then
+ * owns the frames, and frees them one page at a time.
+ *
+ * @param physical Physical address of the block.
+ * @param order Order of the block, as for the frame allocator.
+ * @param size Size of the buffer, in bytes. Rounded up to whole pages, and
+ * to at least the size of the block.
+ *
+ * @return Start of the buffer, or NULL if no buffer could be made, in which
+ * case the block is left as it was.
+ */
+void* vmalloc_adopt(uintptr_t physical, size_t order, size_t size);
+
+/**
+ * @brief Resizes a buffer without copying it. Shrinking frees the pages
+ * past the new end. Growing extends the buffer in place when the window is
+ * free after it, and otherwise moves its pages to a new range by mapping
+ * the same frames there.
+ *
+ * @param ptr Start of the buffer, as returned by vmalloc_allocate or
+ * vmalloc_adopt.
+ * @param size New size of the buffer, in bytes. Rounded up to whole pages.
+ *
+ * @return Start of the resized buffer, or NULL if it could not be grown, in
+ * which case the buffer is left as it was.
+ */
+void* vmalloc_reallocate(void* ptr, size_t size);
+
+/**
+ * @brief Gets the size of a buffer.
+ *
+ * @param ptr Start of the buffer.
+ *
+ * @return Size of the buffer in bytes, a multiple of the page size, or 0 if
+ * ptr does not start a live buffer.
+ */
+size_t vmalloc_get_size(void* ptr);
+
+/**
+ * @brief Checks whether an address lies in the vmalloc window.
+ *
+ * @param ptr Address to check.
+ *
+ * @return True if the address is in the window.
+ */
+static inline bool vmalloc_contains(const void* ptr)
+{
+    return (((uintptr_t) ptr >= VMALLOC_BASE)
+        && ((uintptr_t) ptr < VMALLOC_END));
+}
+
+/**
+ * @brief Backs a faulting page with a frame if it lies in a live vmalloc
+ * buffer.
+ *
+ * @param address Faulting address, from CR2.
+ * @param error Page fault error code.
+ *
+ * @return True if the fault was resolved, false if it was not caused by a
+ * page of a live buffer, or no frame was available.
+ */
+bool vmalloc_handle_fault(uintptr_t address, uint32_t error);
+
+/**
+ * @brief Gets the number of frames currently backing vmalloc buffers.
+ *
+ * @return Number of resident frames.
+ */
+size_t vmalloc_get_resident_count(void);
+
+#endif /* VMALLOC_H_INCLUDED */
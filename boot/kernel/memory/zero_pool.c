@@ -0,0 +1,190 @@
+/*
+ * zero_pool.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string.h>
+
+#include <globals.h>
+#include <boot/cpu.h>
+#include <boot/kernel/spinlock.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/paging.h>
+#include <boot/kernel/memory/zero_pool.h>
+
+/**
+ * @brief Zeroes memory with non-temporal stores, bypassing the caches.
+ *
+ * @param ptr Memory to zero. Must be 16-byte aligned.
+ * @param size Size in bytes. Must be a multiple of 16.
+ */
+static void clear_non_temporal(void* ptr, size_t size);
+
+/**
+ * @brief Zeroed blocks of every order, as physical addresses.
+ */
+static uintptr_t pools[ZERO_POOL_MAX_ORDER + 1][ZERO_POOL_CAPACITY];
+
+/**
+ * @brief Number of blocks in the pool of every order.
+ */
+static size_t counts[ZERO_POOL_MAX_ORDER + 1];
+
+/**
+ * @brief Protects pools and counts.
+ */
+static Spinlock lock;
+
+/**
+ * @brief Whether the CPU supports MOVNTI.
+ */
+static bool non_temporal;
+
+void zero_pool_initialize(void)
+{
+    if (cpu_has_cpuid())
+    {
+        uint32_t eax;
+        uint32_t ebx;
+        uint32_t ecx;
+        uint32_t edx;
+
+        cpu_cpuid(1, &eax, &ebx, &ecx, &edx);
+
+        non_temporal = (edx & CPU_FEATURE_SSE2) != 0;
+    }
+}
+
+bool zero_pool_refill(void)
+{
+    /* Refills the lowest order that is not full, since small blocks are
+     * taken most often. */
+    size_t order = 0;
+
+    while (counts[order] >= ((size_t) ZERO_POOL_CAPACITY >> order))
+    {
+        ++order;
+        if (order > ZERO_POOL_MAX_ORDER)
+        {
+            return (false);
+        }
+    }
+
+    uint32_t state = cpu_save_interrupts();
+    uintptr_t block = frame_allocator_allocate(order);
+    cpu_restore_interrupts(state);
+
+    if (block == 0)
+    {
+        return (false);
+    }
+
+    /* Zeroing is the slow part, so it runs with interrupts enabled. */
+    size_t size = (size_t) FRAME_ALLOCATOR_FRAME_SIZE << order;
+    void* ptr = PAGING_PHYSICAL_TO_VIRTUAL(block);
+
+    if (non_temporal)
+    {
+        clear_non_temporal(ptr, size);
+    }
+    else
+    {
+        memset(ptr, 0, size);
+    }
+
+    state = cpu_save_interrupts();
+    spinlock_acquire(&lock);
+
+    bool added = counts[order] < ((size_t) ZERO_POOL_CAPACITY >> order);
+
+    if (added)
+    {
+        pools[order][counts[order]++] = block;
+    }
+
+    spinlock_release(&lock);
+
+    if (!added)
+    {
+        frame_allocator_free(block, order);
+    }
+
+    cpu_restore_interrupts(state);
+
+    return (added);
+}
+
+uintptr_t zero_pool_allocate(size_t order)
+{
+    if (UNLIKELY(order > ZERO_POOL_MAX_ORDER))
+    {
+        return (0);
+    }
+
+    uintptr_t block = 0;
+    uint32_t state = cpu_save_interrupts();
+
+    spinlock_acquire(&lock);
+    if (counts[order] > 0)
+    {
+        block = pools[order][--counts[order]];
+    }
+    spinlock_release(&lock);
+
+    cpu_restore_interrupts(state);
+
+    return (block);
+}
+
+size_t zero_pool_get_count(size_t order)
+{
+    if (order > ZERO_POOL_MAX_ORDER)
+    {
+        return (0);
+    }
+
+    return (counts[order]);
+}
+
+static void clear_non_temporal(void* ptr, size_t size)
+{
+    uint32_t* word = ptr;
+    uint32_t* end = word + (size / sizeof(uint32_t));
+
+    for (; word < end; word += 4)
+    {
+        asm volatile
+        (
+            "movnti %[zero], 0(%[word])\n"
+            "movnti %[zero], 4(%[word])\n"
+            "movnti %[zero], 8(%[word])\n"
+            "movnti %[zero], 12(%[word])\n"
+            : /* No outputs. */
+            : [zero] "r" (0), [word] "r" (word)
+            : "memory"
+        );
+    }
+
+    /* Orders the non-temporal stores before the block is handed out. */
+    asm volatile ("sfence" ::: "memory");
+}
@@ -0,0 +1,77 @@
+/*
+ * zero_pool.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef ZERO_POOL_H_INCLUDED
+#define ZERO_POOL_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Largest order of block kept zeroed in the pool.
+ */
+#define ZERO_POOL_MAX_ORDER 3
+
+/**
+ * @brief Number of order 0 blocks the pool holds. Each higher order holds
+ * half as many blocks as the one below it, so every order takes the same
+ * amount of memory.
+ */
+#define ZERO_POOL_CAPACITY 16
+
+/**
+ * @brief Checks which way of zeroing the CPU supports. The frame allocator
+ * and paging must already be initialized. The pool starts out empty.
+ */
+void zero_pool_initialize(void);
+
+/**
+ * @brief Zeroes one block and adds it to the pool, if the pool is not full.
+ * Meant to be called from the idle loop, so that zeroing happens while the
+ * CPU has nothing better to do. Zeroing uses non-temporal stores when SSE2
+ * is available, so that it does not evict useful data from the caches.
+ *
+ * @return True if a block was added, false if the pool is full or no memory
+ * is free.
+ */
+bool zero_pool_refill(void);
+
+/**
+ * @brief Takes a zeroed block from the pool.
+ *
+ * @param order Order of the block.
+ *
+ * @return Physical address of the block, as if returned by
+ * frame_allocator_allocate, or 0 if the pool has no block of that order.
+ */
+uintptr_t zero_pool_allocate(size_t order);
+
+/**
+ * @brief Gets the number of zeroed blocks of an order in the pool.
+ *
+ * @param order Order of the blocks.
+ *
+ * @return Number of blocks.
+ */
+size_t zero_pool_get_count(size_t order);
+
+#endif /* ZERO_POOL_H_INCLUDED */
@@ -0,0 +1,251 @@
+/*
+ * random.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <globals.h>
+#include <boot/cpu.h>
+#include <boot/kernel/random/random.h>
+
+/**
+ * @brief Increment of the SplitMix64 generator used for seeding: 2^64
+ * divided by the golden ratio.
+ */
+#define RANDOM_GOLDEN_GAMMA 0x9E3779B97F4A7C15ULL
+
+/**
+ * @brief Number of RDRAND reads random_initialize tries before settling
+ * for the time-stamp counter alone.
+ */
+#define RANDOM_RDRAND_RETRIES 10
+
+/**
+ * @brief Generator of one CPU. Aligned so that no two CPUs share a cache
+ * line.
+ */
+typedef struct Random_Cpu
+{
+    Random random;
+} __attribute__((aligned(64))) Random_Cpu;
+
+/**
+ * @brief Steps a SplitMix64 generator.
+ *
+ * @param state Generator state to step.
+ *
+ * @return Next 64 random bits.
+ */
+static uint64_t split_mix(uint64_t* state);
+
+/**
+ * @brief Gets a seed that differs from boot to boot.
+ *
+ * @return Seed for random_initialize.
+ */
+static uint64_t get_boot_seed(void);
+
+/**
+ * @brief Bits of the xoshiro128** jump polynomial, which advances a
+ * generator by 2^64 steps.
+ */
+static const uint32_t jump_polynomial[4] =
+{
+    0x8764000B, 0xF542D2D3, 0x6FA035C3, 0x77F2DB5B
+};
+
+/**
+ * @brief Per-CPU generators.
+ */
+static Random_Cpu cpus[CPU_MAX_COUNT];
+
+void random_seed(Random* random, uint64_t seed)
+{
+    /* SplitMix64 is a bijection of its counter, so two consecutive outputs
+     * are never both zero. */
+    uint64_t low = split_mix(&seed);
+    uint64_t high = split_mix(&seed);
+
+    random->state[0] = (uint32_t) low;
+    random->state[1] = (uint32_t) (low >> 32);
+    random->state[2] = (uint32_t) high;
+    random->state[3] = (uint32_t) (high >> 32);
+}
+
+void random_jump(Random* random)
+{
+    uint32_t jumped[4] = {0, 0, 0, 0};
+
+    /* Sums the states at the powers of the step that make up the
+     * polynomial, which the generator's linearity turns into a jump. */
+    for (size_t i = 0; i < 4; ++i)
+    {
+        for (size_t bit = 0; bit < 32; ++bit)
+        {
+            if ((jump_polynomial[i] & (1U << bit)) != 0)
+            {
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    jumped[j] ^= random->state[j];
+                }
+            }
+            random_next(random);
+        }
+    }
+
+    for (size_t j = 0; j < 4; ++j)
+    {
+        random->state[j] = jumped[j];
+    }
+}
+
+uint32_t random_next_below(Random* random, uint32_t bound)
+{
+    uint64_t product = (uint64_t) random_next(random) * bound;
+    uint32_t low = (uint32_t) product;
+
+    /* The high halves are biased only through products whose low half
+     * falls below 2^32 mod bound; those are drawn again. The division is
+     * skipped unless the low half is small enough to matter. */
+    if (low < bound)
+    {
+        uint32_t threshold = (0U - bound) % bound;
+
+        while (low < threshold)
+        {
+            product = (uint64_t) random_next(random) * bound;
+            low = (uint32_t) product;
+        }
+    }
+
+    return ((uint32_t) (product >> 32));
+}
+
+void random_fill(Random* random, void* buffer, size_t size)
+{
+    uint8_t* bytes = buffer;
+
+    for (; size >= sizeof(uint32_t); size -= sizeof(uint32_t))
+    {
+        uint32_t word = random_next(random);
+
+        __builtin_memcpy(bytes, &word, sizeof(word));
+        bytes += sizeof(word);
+    }
+
+    if (size > 0)
+    {
+        uint32_t word = random_next(random);
+
+        for (; size > 0; --size)
+        {
+            *bytes = (uint8_t) word;
+            word >>= 8;
+            ++bytes;
+        }
+    }
+}
+
+void random_initialize(void)
+{
+    Random random;
+
+    random_seed(&random, get_boot_seed());
+
+    for (size_t i = 0; i < CPU_MAX_COUNT; ++i)
+    {
+        cpus[i].random = random;
+        random_jump(&random);
+    }
+}
+
+uint32_t random_get(void)
+{
+    uint32_t state = cpu_save_interrupts();
+    uint32_t ret = random_next(&cpus[cpu_get_id()].random);
+
+    cpu_restore_interrupts(state);
+    return (ret);
+}
+
+uint32_t random_get_below(uint32_t bound)
+{
+    uint32_t state = cpu_save_interrupts();
+    uint32_t ret = random_next_below(&cpus[cpu_get_id()].random, bound);
+
+    cpu_restore_interrupts(state);
+    return (ret);
+}
+
+void random_get_bytes(void* buffer, size_t size)
+{
+    uint32_t state = cpu_save_interrupts();
+
+    random_fill(&cpus[cpu_get_id()].random, buffer, size);
+    cpu_restore_interrupts(state);
+}
+
+static uint64_t split_mix(uint64_t* state)
+{
+    *state += RANDOM_GOLDEN_GAMMA;
+
+    uint64_t z = *state;
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+    return (z ^ (z >> 31));
+}
+
+static uint64_t get_boot_seed(void)
+{
+    uint64_t seed = cpu_read_timestamp_counter();
+
+    if (!cpu_has_cpuid())
+    {
+        return (seed);
+    }
+
+    uint32_t eax;
+    uint32_t ebx;
+    uint32_t ecx;
+    uint32_t edx;
+
+    cpu_cpuid(1, &eax, &ebx, &ecx, &edx);
+
+    if ((ecx & CPU_FEATURE_RDRAND) == 0)
+    {
+        return (seed);
+    }
+
+    uint32_t value;
+
+    for (size_t i = 0; i < RANDOM_RDRAND_RETRIES; ++i)
+    {
+        if (cpu_read_random(&value))
+        {
+            return (seed ^ ((uint64_t) value << 32));
+        }
+    }
+
+    return (seed);
+}
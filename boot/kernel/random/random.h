@@ -0,0 +1,136 @@
+/*
+ * random.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef RANDOM_H_INCLUDED
+#define RANDOM_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief State of an xoshiro128** generator: 128 bits that must not all be
+ * zero. Each generator is deterministic given its seed, and is not safe to
+ * share between CPUs without a lock.
+ */
+typedef struct Random
+{
+    uint32_t state[4];
+} Random;
+
+/**
+ * @brief Seeds a generator, expanding the seed with SplitMix64 so that
+ * nearby seeds give unrelated sequences.
+ *
+ * @param random Generator to seed.
+ * @param seed Any value, including 0.
+ */
+void random_seed(Random* random, uint64_t seed);
+
+/**
+ * @brief Advances a generator by 2^64 steps, as if random_next had been
+ * called that many times. Jumping copies of one generator gives each a
+ * sequence that cannot overlap the others.
+ *
+ * @param random Generator to advance.
+ */
+void random_jump(Random* random);
+
+/**
+ * @brief Gets a random integer in the range 0 to bound - 1 without modulo
+ * bias, from the high half of a 64-bit product (Lemire's method).
+ *
+ * @param random Generator to use.
+ * @param bound Number of possible results, at least 1.
+ *
+ * @return Random integer below bound.
+ */
+uint32_t random_next_below(Random* random, uint32_t bound);
+
+/**
+ * @brief Fills a buffer with random bytes, a word at a time.
+ *
+ * @param random Generator to use.
+ * @param buffer Buffer to fill.
+ * @param size Size of buffer in bytes.
+ */
+void random_fill(Random* random, void* buffer, size_t size);
+
+/**
+ * @brief Seeds a generator for each CPU from one boot-time seed, taken
+ * from RDRAND where supported and mixed with the time-stamp counter. Each
+ * CPU's generator is a jump ahead of the last.
+ */
+void random_initialize(void);
+
+/**
+ * @brief Gets a random integer from the calling CPU's generator. Takes no
+ * lock, and is safe to call from interrupt handlers.
+ *
+ * @return Random 32-bit integer.
+ */
+uint32_t random_get(void);
+
+/**
+ * @brief Gets a random integer below bound from the calling CPU's
+ * generator. See random_next_below.
+ *
+ * @param bound Number of possible results, at least 1.
+ *
+ * @return Random integer below bound.
+ */
+uint32_t random_get_below(uint32_t bound);
+
+/**
+ * @brief Fills a buffer with random bytes from the calling CPU's
+ * generator.
+ *
+ * @param buffer Buffer to fill.
+ * @param size Size of buffer in bytes.
+ */
+void random_get_bytes(void* buffer, size_t size);
+
+/**
+ * @brief Gets the next 32 random bits from a generator (xoshiro128**).
+ * Inline, as it is only a few shifts and two multiplications.
+ *
+ * @param random Generator to use.
+ *
+ * @return Random 32-bit integer.
+ */
+static inline uint32_t random_next(Random* random)
+{
+    uint32_t* s = random->state;
+    uint32_t x = s[1] * 5;
+    uint32_t ret = ((x << 7) | (x >> 25)) * 9;
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+
+    return (ret);
+}
+
+#endif /* RANDOM_H_INCLUDED */
@@ -0,0 +1,168 @@
+/*
+ * simd.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <globals.h>
+#include <boot/cpu.h>
+#include <boot/kernel/simd/simd.h>
+
+/**
+ * @brief CR0 bit making WAIT and FWAIT honour the task-switched flag.
+ */
+#define CR0_MP 0x00000002
+
+/**
+ * @brief CR0 bit making x87 and SSE instructions raise #UD (emulation).
+ */
+#define CR0_EM 0x00000004
+
+/**
+ * @brief CR0 bit making x87 and SSE instructions raise #NM (task switched).
+ */
+#define CR0_TS 0x00000008
+
+/**
+ * @brief CR4 bit enabling FXSAVE, FXRSTOR and SSE instructions.
+ */
+#define CR4_OSFXSR 0x00000200
+
+/**
+ * @brief CR4 bit reporting unmasked SSE exceptions as #XM.
+ */
+#define CR4_OSXMMEXCPT 0x00000400
+
+/**
+ * @brief CR4 bit enabling XSETBV and the state selected by XCR0.
+ */
+#define CR4_OSXSAVE 0x00040000
+
+/**
+ * @brief XCR0 bits for x87, SSE and AVX state, all of which AVX needs.
+ */
+#define XCR0_AVX_STATE 0x7
+
+/**
+ * @brief Implementations handed out by simd_begin, or NULL without SIMD.
+ */
+static const Simd_Functions* functions;
+
+/**
+ * @brief Extension chosen by simd_initialize.
+ */
+static Simd_Level level;
+
+/**
+ * @brief Whether each CPU's vector registers are claimed.
+ */
+static volatile bool claimed[CPU_MAX_COUNT];
+
+void simd_initialize(void)
+{
+    if (!cpu_has_cpuid())
+    {
+        return;
+    }
+
+    uint32_t eax;
+    uint32_t ebx;
+    uint32_t ecx;
+    uint32_t edx;
+
+    cpu_cpuid(1, &eax, &ebx, &ecx, &edx);
+
+    if ((edx & (CPU_FEATURE_FXSR | CPU_FEATURE_SSE2))
+        != (CPU_FEATURE_FXSR | CPU_FEATURE_SSE2))
+    {
+        return;
+    }
+
+    uint32_t features = ecx;
+
+    cpu_write_cr0((cpu_read_cr0() & ~(CR0_EM | CR0_TS)) | CR0_MP);
+    cpu_write_cr4(cpu_read_cr4() | CR4_OSFXSR | CR4_OSXMMEXCPT);
+
+    asm volatile
+    (
+        "fninit\n"
+        : /* No outputs. */
+        : /* No inputs. */
+        : /* No clobbers. */
+    );
+
+    level = SIMD_SSE2;
+    functions = &simd_sse2_functions;
+
+    if ((features & (CPU_FEATURE_XSAVE | CPU_FEATURE_AVX))
+        != (CPU_FEATURE_XSAVE | CPU_FEATURE_AVX))
+    {
+        return;
+    }
+
+    cpu_cpuid(0, &eax, &ebx, &ecx, &edx);
+
+    if (eax < 7)
+    {
+        return;
+    }
+
+    cpu_cpuid(7, &eax, &ebx, &ecx, &edx);
+
+    if ((ebx & CPU_FEATURE_AVX2) == 0)
+    {
+        return;
+    }
+
+    /* AVX instructions raise #UD until the OS enables their state. */
+    cpu_write_cr4(cpu_read_cr4() | CR4_OSXSAVE);
+    cpu_write_xcr0(cpu_read_xcr0() | XCR0_AVX_STATE);
+
+    level = SIMD_AVX2;
+    functions = &simd_avx2_functions;
+}
+
+Simd_Level simd_get_level(void)
+{
+    return (level);
+}
+
+const Simd_Functions* simd_begin(void)
+{
+    uint32_t id = cpu_get_id();
+
+    /* An interrupt taken after this check but before the claim finishes
+     * with the registers before returning, so no state is lost. */
+    if (functions == NULL || claimed[id])
+    {
+        return (NULL);
+    }
+
+    claimed[id] = true;
+
+    return (functions);
+}
+
+void simd_end(void)
+{
+    claimed[cpu_get_id()] = false;
+}
@@ -0,0 +1,114 @@
+/*
+ * simd.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef SIMD_H_INCLUDED
+#define SIMD_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Smallest size, in bytes, passed to the sized SIMD functions. Below
+ * it the scalar code is as fast, and the functions rely on being able to
+ * cover the ends with whole vectors.
+ */
+#define SIMD_MINIMUM_SIZE 64
+
+/**
+ * @brief Size from which SIMD copies and fills use non-temporal stores,
+ * since a buffer this large would only evict the rest of the cache.
+ */
+#define SIMD_NON_TEMPORAL_SIZE (256 * 1024)
+
+/**
+ * @brief Widest vector extension the kernel uses.
+ */
+typedef enum Simd_Level
+{
+    SIMD_NONE,
+    SIMD_SSE2,
+    SIMD_AVX2
+} Simd_Level;
+
+/**
+ * @brief Vector implementations of the string and memory functions, for one
+ * extension. Sized functions are only called with at least
+ * SIMD_MINIMUM_SIZE bytes.
+ */
+typedef struct Simd_Functions
+{
+    /* Copies n bytes between objects that do not overlap. */
+    void (*copy)(void* s, const void* ct, size_t n);
+
+    /* Sets n bytes to c. */
+    void (*fill)(void* s, uint8_t c, size_t n);
+
+    /* Compares n bytes, returning 1, 0 or -1 as memcmp does. */
+    int (*compare)(const void* cs, const void* ct, size_t n);
+
+    /* Finds the first of n bytes equal to c, or returns NULL. */
+    void* (*find)(const void* cs, uint8_t c, size_t n);
+
+    /* Gets the length of a null-terminated string. */
+    size_t (*length)(const char* cs);
+} Simd_Functions;
+
+/**
+ * @brief SSE2 implementations.
+ */
+extern const Simd_Functions simd_sse2_functions;
+
+/**
+ * @brief AVX2 implementations.
+ */
+extern const Simd_Functions simd_avx2_functions;
+
+/**
+ * @brief Probes CPUID for the widest supported extension and enables the
+ * register state it needs. Until this is called, and on CPUs without SSE2,
+ * the string functions use their scalar code.
+ */
+void simd_initialize(void);
+
+/**
+ * @brief Gets the extension chosen by simd_initialize.
+ *
+ * @return Widest extension in use.
+ */
+Simd_Level simd_get_level(void);
+
+/**
+ * @brief Claims the vector registers of the current CPU. Registers are not
+ * saved on interrupts, so an interrupt handler that finds them claimed
+ * gets NULL and must use scalar code instead.
+ *
+ * @return Implementations to call until simd_end, or NULL if there is no
+ * SIMD support or the registers are already claimed.
+ */
+const Simd_Functions* simd_begin(void);
+
+/**
+ * @brief Releases the vector registers claimed by simd_begin.
+ */
+void simd_end(void);
+
+#endif /* SIMD_H_INCLUDED */
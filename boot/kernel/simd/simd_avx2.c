@@ -0,0 +1,66 @@
+/*
+ * simd_avx2.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdint.h>
+
+/**
+ * @brief Size of a vector register, in bytes.
+ */
+#define VECTOR_SIZE 32
+
+/**
+ * @brief Comparison mask with a bit set for every byte of a vector.
+ */
+#define MASK_ALL 0xFFFFFFFF
+
+/**
+ * @brief Lets the compiler use AVX2 instructions in a function.
+ */
+#define SIMD_TARGET __attribute__((target("avx2")))
+
+#include <boot/kernel/simd/simd_body.h>
+
+const Simd_Functions simd_avx2_functions =
+{
+    .copy = copy,
+    .fill = fill,
+    .compare = compare,
+    .find = find,
+    .length = length
+};
+
+SIMD_TARGET
+static inline uint32_t match(Vector a, Vector b)
+{
+    return ((uint32_t) __builtin_ia32_pmovmskb256((Byte_Vector) (a == b)));
+}
+
+SIMD_TARGET
+static inline Vector broadcast(uint8_t c)
+{
+    return ((Vector) {} + (char) c);
+}
+
+SIMD_TARGET
+static inline void stream(void* s, Vector value)
+{
+    __builtin_ia32_movntdq256((Quad_Vector*) s, (Quad_Vector) value);
+}
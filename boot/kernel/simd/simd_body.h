@@ -0,0 +1,309 @@
+/*
+ * simd_body.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+/* Vector implementations of the Simd_Functions, shared by every backend.
+ * A backend defines VECTOR_SIZE, MASK_ALL (the match mask with a bit for
+ * every byte of a vector) and SIMD_TARGET (the target attribute of its
+ * instruction set), includes this file once, and then defines match,
+ * broadcast and stream and its table of the functions. */
+
+#ifndef SIMD_BODY_H_INCLUDED
+#define SIMD_BODY_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <globals.h>
+#include <boot/kernel/simd/simd.h>
+
+/**
+ * @brief Aligned vector of bytes, which may alias any object.
+ */
+typedef char Vector __attribute__((vector_size(VECTOR_SIZE), may_alias));
+
+/**
+ * @brief Unaligned vector of bytes, which may alias any object.
+ */
+typedef char Unaligned_Vector
+    __attribute__((vector_size(VECTOR_SIZE), may_alias, aligned(1)));
+
+/**
+ * @brief Vector types taken by the compiler's built-in functions.
+ */
+typedef char Byte_Vector __attribute__((vector_size(VECTOR_SIZE)));
+typedef long long Quad_Vector __attribute__((vector_size(VECTOR_SIZE)));
+
+/**
+ * @brief Copies n bytes between objects that do not overlap.
+ *
+ * @param s Destination.
+ * @param ct Source.
+ * @param n Number of bytes, at least SIMD_MINIMUM_SIZE.
+ */
+static void copy(void* s, const void* ct, size_t n);
+
+/**
+ * @brief Sets n bytes to c.
+ *
+ * @param s Destination.
+ * @param c Value to set.
+ * @param n Number of bytes, at least SIMD_MINIMUM_SIZE.
+ */
+static void fill(void* s, uint8_t c, size_t n);
+
+/**
+ * @brief Compares n bytes.
+ *
+ * @param cs First object.
+ * @param ct Second object.
+ * @param n Number of bytes, at least SIMD_MINIMUM_SIZE.
+ *
+ * @return 1, 0 or -1 as the first differing byte of cs is greater, there
+ * is none, or it is less.
+ */
+static int compare(const void* cs, const void* ct, size_t n);
+
+/**
+ * @brief Finds the first of n bytes equal to c. Reads whole aligned
+ * vectors and stops at the first that holds c, so the object may end at
+ * the byte found even if n is larger.
+ *
+ * @param cs Object to search.
+ * @param c Value to find.
+ * @param n Number of bytes, at least SIMD_MINIMUM_SIZE.
+ *
+ * @return Pointer to the byte, or NULL if there is none.
+ */
+static void* find(const void* cs, uint8_t c, size_t n);
+
+/**
+ * @brief Gets the length of a null-terminated string. Reads whole aligned
+ * vectors, which never cross into a page the string does not use.
+ *
+ * @param cs String.
+ *
+ * @return Number of characters before the terminator.
+ */
+static size_t length(const char* cs);
+
+/**
+ * @brief Gets a mask with a bit set for every equal byte of two vectors.
+ *
+ * @param a First vector.
+ * @param b Second vector.
+ *
+ * @return Mask with bit i set if byte i of a and b are equal.
+ */
+static inline uint32_t match(Vector a, Vector b);
+
+/**
+ * @brief Creates a vector with every byte set to c.
+ *
+ * @param c Value of the bytes.
+ *
+ * @return Vector.
+ */
+static inline Vector broadcast(uint8_t c);
+
+/**
+ * @brief Stores a vector without bringing its line into the cache.
+ *
+ * @param s Aligned destination.
+ * @param value Vector to store.
+ */
+static inline void stream(void* s, Vector value);
+
+SIMD_TARGET
+static void copy(void* s, const void* ct, size_t n)
+{
+    uint8_t* s1 = (uint8_t*) s;
+    const uint8_t* ct1 = (const uint8_t*) ct;
+
+    /* The ends are copied with unaligned vectors, so that the loops only
+     * store to aligned ones. */
+    Vector head = *((const Unaligned_Vector*) ct1);
+    Vector tail = *((const Unaligned_Vector*) (ct1 + n - VECTOR_SIZE));
+    size_t offset = VECTOR_SIZE - ((uintptr_t) s1 & (VECTOR_SIZE - 1));
+
+    if (n >= SIMD_NON_TEMPORAL_SIZE)
+    {
+        for (; offset + (4 * VECTOR_SIZE) <= n; offset += 4 * VECTOR_SIZE)
+        {
+            for (size_t i = 0; i < 4 * VECTOR_SIZE; i += VECTOR_SIZE)
+            {
+                stream(
+                    s1 + offset + i,
+                    *((const Unaligned_Vector*) (ct1 + offset + i)));
+            }
+        }
+
+        /* Orders the non-temporal stores before anything that follows. */
+        __builtin_ia32_sfence();
+    }
+    else
+    {
+        for (; offset + (4 * VECTOR_SIZE) <= n; offset += 4 * VECTOR_SIZE)
+        {
+            for (size_t i = 0; i < 4 * VECTOR_SIZE; i += VECTOR_SIZE)
+            {
+                *((Vector*) (s1 + offset + i))
+                    = *((const Unaligned_Vector*) (ct1 + offset + i));
+            }
+        }
+    }
+
+    for (; offset + VECTOR_SIZE <= n; offset += VECTOR_SIZE)
+    {
+        *((Vector*) (s1 + offset))
+            = *((const Unaligned_Vector*) (ct1 + offset));
+    }
+
+    *((Unaligned_Vector*) s1) = head;
+    *((Unaligned_Vector*) (s1 + n - VECTOR_SIZE)) = tail;
+}
+
+SIMD_TARGET
+static void fill(void* s, uint8_t c, size_t n)
+{
+    uint8_t* s1 = (uint8_t*) s;
+    Vector value = broadcast(c);
+    size_t offset = VECTOR_SIZE - ((uintptr_t) s1 & (VECTOR_SIZE - 1));
+
+    *((Unaligned_Vector*) s1) = value;
+
+    if (n >= SIMD_NON_TEMPORAL_SIZE)
+    {
+        for (; offset + VECTOR_SIZE <= n; offset += VECTOR_SIZE)
+        {
+            stream(s1 + offset, value);
+        }
+
+        __builtin_ia32_sfence();
+    }
+    else
+    {
+        for (; offset + VECTOR_SIZE <= n; offset += VECTOR_SIZE)
+        {
+            *((Vector*) (s1 + offset)) = value;
+        }
+    }
+
+    *((Unaligned_Vector*) (s1 + n - VECTOR_SIZE)) = value;
+}
+
+SIMD_TARGET
+static int compare(const void* cs, const void* ct, size_t n)
+{
+    const uint8_t* cs1 = (const uint8_t*) cs;
+    const uint8_t* ct1 = (const uint8_t*) ct;
+    size_t offset = 0;
+
+    for (;;)
+    {
+        /* The last vector is moved back to end at n; the bytes it covers
+         * twice are already known to be equal. */
+        if (offset + VECTOR_SIZE > n)
+        {
+            if (offset == n)
+            {
+                return (0);
+            }
+
+            offset = n - VECTOR_SIZE;
+        }
+
+        uint32_t mask = match(
+            *((const Unaligned_Vector*) (cs1 + offset)),
+            *((const Unaligned_Vector*) (ct1 + offset)));
+
+        if (mask != MASK_ALL)
+        {
+            offset += __builtin_ctz(~mask);
+            return ((cs1[offset] > ct1[offset]) ? 1 : -1);
+        }
+
+        offset += VECTOR_SIZE;
+    }
+}
+
+SIMD_TARGET
+static void* find(const void* cs, uint8_t c, size_t n)
+{
+    const uint8_t* cs1 = (const uint8_t*) cs;
+    const uint8_t* end = cs1 + n;
+    Vector value = broadcast(c);
+    uintptr_t misalignment = (uintptr_t) cs1 & (VECTOR_SIZE - 1);
+    const uint8_t* block = cs1 - misalignment;
+
+    /* As in length, only whole aligned vectors are read, so the search
+     * never reads a page past the vector holding the first match; callers
+     * rely on that to search strings of unknown length. Bytes before cs in
+     * the first vector are ignored. */
+    uint32_t mask = match(*((const Vector*) block), value) >> misalignment;
+    const uint8_t* found = cs1;
+
+    while (mask == 0)
+    {
+        block += VECTOR_SIZE;
+
+        if (block >= end)
+        {
+            return (NULL);
+        }
+
+        mask = match(*((const Vector*) block), value);
+        found = block;
+    }
+
+    /* The last vector may hold bytes past n. */
+    found += __builtin_ctz(mask);
+    return ((found < end) ? (void*) found : NULL);
+}
+
+SIMD_TARGET
+static size_t length(const char* cs)
+{
+    Vector zero = broadcast(0);
+    uintptr_t misalignment = (uintptr_t) cs & (VECTOR_SIZE - 1);
+    const char* block = cs - misalignment;
+
+    /* Bytes before the string in its first vector are ignored. */
+    uint32_t mask = match(*((const Vector*) block), zero) >> misalignment;
+
+    if (mask != 0)
+    {
+        return (__builtin_ctz(mask));
+    }
+
+    for (;;)
+    {
+        block += VECTOR_SIZE;
+        mask = match(*((const Vector*) block), zero);
+
+        if (mask != 0)
+        {
+            return ((size_t) (block - cs) + __builtin_ctz(mask));
+        }
+    }
+}
+
+#endif /* SIMD_BODY_H_INCLUDED */
@@ -0,0 +1,76 @@
+/*
+ * spinlock.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef SPINLOCK_H_INCLUDED
+#define SPINLOCK_H_INCLUDED
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Lock that busy-waits until it is free. Zero is unlocked, so static
+ * locks need no initialization. Holders must keep interrupts disabled, or an
+ * interrupt handler taking the same lock would spin forever.
+ */
+typedef volatile uint32_t Spinlock;
+
+/**
+ * @brief Acquires a lock, spinning until it is free.
+ *
+ * @param lock Lock to acquire.
+ */
+static inline void spinlock_acquire(Spinlock* lock)
+{
+    while (__sync_lock_test_and_set(lock, 1) != 0)
+    {
+        /* Spins on plain reads so that waiters share the cache line until
+         * the lock looks free. */
+        while (*lock != 0)
+        {
+            asm volatile ("pause" ::: "memory");
+        }
+    }
+}
+
+/**
+ * @brief Acquires a lock only if it is free, without spinning.
+ *
+ * @param lock Lock to acquire.
+ *
+ * @return True if the lock was acquired.
+ */
+static inline bool spinlock_try_acquire(Spinlock* lock)
+{
+    return (__sync_lock_test_and_set(lock, 1) == 0);
+}
+
+/**
+ * @brief Releases a lock.
+ *
+ * @param lock Lock to release.
+ */
+static inline void spinlock_release(Spinlock* lock)
+{
+    __sync_lock_release(lock);
+}
+
+#endif /* SPINLOCK_H_INCLUDED */
@@ -0,0 +1,239 @@
+/*
+ * string_builder.c
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <globals.h>
+#include <boot/kernel/string_builder/string_builder.h>
+
+/**
+ * @brief Grows the memory of a builder to hold at least the given length,
+ * at least doubling it so that a string built by appends is copied O(1)
+ * times per character.
+ *
+ * @param builder Builder to grow. Must own its memory.
+ * @param capacity Length to make room for, not counting the null
+ * terminator.
+ *
+ * @return Whether the memory could be grown.
+ */
+static bool grow_builder(String_Builder* builder, size_t capacity);
+
+void string_builder_initialize(String_Builder* builder)
+{
+    builder->data = NULL;
+    builder->length = 0;
+    builder->capacity = 0;
+    builder->owned = true;
+    builder->truncated = false;
+}
+
+void string_builder_initialize_buffer(String_Builder* builder, char* buffer,
+    size_t size)
+{
+    builder->data = (size > 0) ? buffer : NULL;
+    builder->length = 0;
+    builder->capacity = (size > 0) ? size - 1 : 0;
+    builder->owned = false;
+    builder->truncated = false;
+
+    if (builder->data != NULL)
+    {
+        builder->data[0] = '\0';
+    }
+}
+
+void string_builder_destroy(String_Builder* builder)
+{
+    if (builder->owned)
+    {
+        free(builder->data);
+    }
+
+    string_builder_initialize(builder);
+}
+
+bool string_builder_reserve(String_Builder* builder, size_t capacity)
+{
+    if (capacity <= builder->capacity)
+    {
+        return (true);
+    }
+
+    return (builder->owned && grow_builder(builder, capacity));
+}
+
+void string_builder_clear(String_Builder* builder)
+{
+    builder->length = 0;
+    builder->truncated = false;
+
+    if (builder->data != NULL)
+    {
+        builder->data[0] = '\0';
+    }
+}
+
+void string_builder_append_length(String_Builder* builder, const char* s,
+    size_t length)
+{
+    size_t room = builder->capacity - builder->length;
+
+    if ((length > room) && !(builder->owned
+        && (length <= SIZE_MAX - builder->length)
+        && grow_builder(builder, builder->length + length)))
+    {
+        length = room;
+        builder->truncated = true;
+    }
+
+    if (builder->data == NULL)
+    {
+        return;
+    }
+
+    memcpy(builder->data + builder->length, s, length);
+    builder->length += length;
+    builder->data[builder->length] = '\0';
+}
+
+void string_builder_append(String_Builder* builder, const char* s)
+{
+    string_builder_append_length(builder, s, strlen(s));
+}
+
+void string_builder_append_char(String_Builder* builder, char c)
+{
+    /* The common case skips the general path. */
+    if (builder->length < builder->capacity)
+    {
+        builder->data[builder->length++] = c;
+        builder->data[builder->length] = '\0';
+        return;
+    }
+
+    string_builder_append_length(builder, &c, 1);
+}
+
+void string_builder_append_fmt(String_Builder* builder, const char* format,
+    ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    string_builder_append_vfmt(builder, format, args);
+    va_end(args);
+}
+
+void string_builder_append_vfmt(String_Builder* builder, const char* format,
+    va_list args)
+{
+    /* The arguments are kept in case the output has to be formatted again
+     * after growing. */
+    va_list retry;
+
+    va_copy(retry, args);
+
+    size_t room = builder->capacity - builder->length;
+    char* end = (builder->data != NULL) ? builder->data + builder->length
+        : NULL;
+    int ret = vsnprintf(end, (end != NULL) ? room + 1 : 0, format, args);
+
+    if (ret < 0)
+    {
+        /* Drops whatever part was written. */
+        if (end != NULL)
+        {
+            *end = '\0';
+        }
+        builder->truncated = true;
+    }
+    else if ((size_t) ret <= room)
+    {
+        builder->length += (size_t) ret;
+    }
+    else if (builder->owned && grow_builder(builder,
+        builder->length + (size_t) ret))
+    {
+        vsnprintf(builder->data + builder->length, (size_t) ret + 1, format,
+            retry);
+        builder->length += (size_t) ret;
+    }
+    else
+    {
+        /* vsnprintf kept as much as fit. */
+        builder->length += room;
+        builder->truncated = true;
+    }
+
+    va_end(retry);
+}
+
+static bool grow_builder(String_Builder* builder, size_t capacity)
+{
+    /* The null terminator needs a byte as well. */
+    if (capacity == SIZE_MAX)
+    {
+        return (false);
+    }
+
+    size_t size = builder->capacity * 2;
+
+    /* Doubling overflowed if halving does not give the capacity back. */
+    if ((size < capacity) || ((size / 2) != builder->capacity))
+    {
+        size = capacity;
+    }
+    if (size < STRING_BUILDER_MINIMUM_CAPACITY)
+    {
+        size = STRING_BUILDER_MINIMUM_CAPACITY;
+    }
+
+    /* Falls back to the exact size if doubling is too much to ask for. */
+    char* data = realloc(builder->data, size + 1);
+
+    if ((data == NULL) && (size > capacity))
+    {
+        size = capacity;
+        data = realloc(builder->data, size + 1);
+    }
+    if (data == NULL)
+    {
+        return (false);
+    }
+
+    /* The first allocation has to be terminated. */
+    if (builder->data == NULL)
+    {
+        data[0] = '\0';
+    }
+
+    builder->data = data;
+    builder->capacity = size;
+    return (true);
+}
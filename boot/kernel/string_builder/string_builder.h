@@ -0,0 +1,182 @@
+/*
+ * string_builder.h
+ *
+ * Copyright 2014 Seth Nils <altindiefanboy@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef STRING_BUILDER_H_INCLUDED
+#define STRING_BUILDER_H_INCLUDED
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <stdio.h>
+
+/**
+ * @brief Smallest capacity a builder allocates, in characters.
+ */
+#define STRING_BUILDER_MINIMUM_CAPACITY 32
+
+/**
+ * @brief String that tracks its own length and capacity, so that appending
+ * never measures or rescans what is already there. It either owns memory
+ * from malloc, which grows by doubling, or writes into a fixed buffer from
+ * its caller and never allocates.
+ */
+typedef struct String_Builder
+{
+    /* Null-terminated contents, or NULL before anything is stored. */
+    char* data;
+
+    /* Length of the contents. */
+    size_t length;
+
+    /* Characters data can hold, not counting the null terminator. */
+    size_t capacity;
+
+    /* Whether data came from malloc and can grow. */
+    bool owned;
+
+    /* Whether an append was cut short for lack of memory or space. */
+    bool truncated;
+} String_Builder;
+
+/**
+ * @brief Initializes an empty builder that allocates memory as it grows.
+ * Nothing is allocated until the first append or reservation.
+ *
+ * @param builder Builder to initialize.
+ */
+void string_builder_initialize(String_Builder* builder);
+
+/**
+ * @brief Initializes an empty builder that writes into a fixed buffer.
+ * Appends that do not fit are cut short instead of allocating.
+ *
+ * @param builder Builder to initialize.
+ * @param buffer Buffer to write into. It is always kept null-terminated.
+ * @param size Size of buffer in bytes, including the null terminator.
+ */
+void string_builder_initialize_buffer(String_Builder* builder, char* buffer,
+    size_t size);
+
+/**
+ * @brief Frees the memory of a builder and leaves it empty. A builder with
+ * a fixed buffer only forgets the buffer.
+ *
+ * @param builder Builder to destroy.
+ */
+void string_builder_destroy(String_Builder* builder);
+
+/**
+ * @brief Makes sure a builder can hold a string of the given length, so
+ * that a message of known size is built with a single allocation.
+ *
+ * @param builder Builder to reserve space in.
+ * @param capacity Length to make room for, not counting the null
+ * terminator.
+ *
+ * @return Whether the builder can now hold capacity characters.
+ */
+bool string_builder_reserve(String_Builder* builder, size_t capacity);
+
+/**
+ * @brief Empties a builder, keeping its memory, and clears its truncated
+ * flag.
+ *
+ * @param builder Builder to empty.
+ */
+void string_builder_clear(String_Builder* builder);
+
+/**
+ * @brief Appends characters to a builder.
+ *
+ * @param builder Builder to append to.
+ * @param s Characters to append. They need not be null-terminated.
+ * @param length Number of characters to append.
+ */
+void string_builder_append_length(String_Builder* builder, const char* s,
+    size_t length);
+
+/**
+ * @brief Appends a string to a builder.
+ *
+ * @param builder Builder to append to.
+ * @param s String to append.
+ */
+void string_builder_append(String_Builder* builder, const char* s);
+
+/**
+ * @brief Appends a character to a builder.
+ *
+ * @param builder Builder to append to.
+ * @param c Character to append.
+ */
+void string_builder_append_char(String_Builder* builder, char c);
+
+/**
+ * @brief Appends formatted output to a builder, formatting straight into
+ * its free space. The format is only run a second time if the output did
+ * not fit and the builder had to grow.
+ *
+ * @param builder Builder to append to.
+ * @param format Format string, as for printf.
+ */
+void string_builder_append_fmt(String_Builder* builder, const char* format,
+    ...) PRINTF_FORMAT(2, 3);
+
+/**
+ * @brief Appends formatted output to a builder, taking the arguments as a
+ * va_list.
+ *
+ * @param builder Builder to append to.
+ * @param format Format string, as for printf.
+ * @param args Arguments to format.
+ */
+void string_builder_append_vfmt(String_Builder* builder, const char* format,
+    va_list args) PRINTF_FORMAT(2, 0);
+
+/**
+ * @brief Gets the contents of a builder. The string stays valid until the
+ * builder is next changed.
+ *
+ * @param builder Builder to read.
+ *
+ * @return Null-terminated contents, which are "" for an empty builder.
+ */
+static inline const char* string_builder_get_string(
+    const String_Builder* builder)
+{
+    return ((builder->data != NULL) ? builder->data : "");
+}
+
+/**
+ * @brief Gets the length of the contents of a builder.
+ *
+ * @param builder Builder to read.
+ *
+ * @return Length of the contents.
+ */
+static inline size_t string_builder_get_length(const String_Builder* builder)
+{
+    return (builder->length);
+}
+
+#endif /* STRING_BUILDER_H_INCLUDED */
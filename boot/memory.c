@@ -23,15 +23,108 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <globals.h>
 #include <boot/memory.h>
+#include <boot/memory_map.h>
+#include <boot/multiboot.h>
+#include <boot/kernel/memory/frame_allocator.h>
+#include <boot/kernel/memory/paging.h>
+#include <boot/kernel/memory/slab.h>
+#include <boot/kernel/memory/zero_pool.h>
+
+/**
+ * @brief Moves an address past any boot module or Multiboot structure
+ * that lies at or above it, so that the arena does not overwrite them.
+ * Bootloaders place these right after the kernel image, so in practice the
+ * arena starts where they end and no memory is skipped.
+ *
+ * @param address Address to start from.
+ *
+ * @return First address past every boot structure above address.
+ */
+static uintptr_t skip_boot_data(uintptr_t address);
+
+/**
+ * @brief Moves an address past the end of a range if the range ends above
+ * it.
+ *
+ * @param address Address to start from.
+ * @param end End of the range.
+ *
+ * @return Address, or the end of the range if that is greater.
+ */
+static inline uintptr_t skip_range(uintptr_t address, uintptr_t end);
+
+/**
+ * @brief Whether the arena has been handed off to the frame allocator.
+ */
+static bool arena_closed;
 
 void memory_initialize(void)
 {
-    memory_start = (void*) (1024 * 1024 * 2); /* 2 MiB */
+    memory_start = (void*) skip_boot_data((uintptr_t) __kernel_end);
     memory_location = memory_start;
+
+    /* The frame allocator takes its bookkeeping from the arena and then
+     * owns every frame the arena did not hand out. */
+    frame_allocator_initialize();
+    arena_closed = true;
+
+    /* From here on, frames are reached through the direct map. */
+    paging_initialize();
+
+    /* The kernel heap is built on top of the frame allocator. */
+    slab_initialize();
+
+    /* Zeroed blocks are only made once the kernel goes idle. */
+    zero_pool_initialize();
+}
+
+void* memory_allocate(size_t size, size_t alignment)
+{
+    if (UNLIKELY(arena_closed))
+    {
+        return (NULL);
+    }
+
+    uintptr_t address = ((uintptr_t) memory_location + alignment - 1)
+        & ~(alignment - 1);
+
+    memory_location = (void*) (address + size);
+
+    return ((void*) address);
+}
+
+static uintptr_t skip_boot_data(uintptr_t address)
+{
+    if ((multiboot_info_structure.flags & MULTIBOOT_FLAG_MODULES) != 0)
+    {
+        module_t* modules = (module_t*) multiboot_info_structure.mods_addr;
+        size_t count = multiboot_info_structure.mods_count;
+
+        address = skip_range(address, (uintptr_t) &modules[count]);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            address = skip_range(address, modules[i].mod_end);
+        }
+    }
+
+    if ((multiboot_info_structure.flags & MULTIBOOT_FLAG_MEMORY_MAP) != 0)
+    {
+        address = skip_range(
+            address,
+            multiboot_info_structure.mmap_addr
+                + multiboot_info_structure.mmap_length);
+    }
+
+    return (address);
+}
+
+static inline uintptr_t skip_range(uintptr_t address, uintptr_t end)
+{
+    return ((end > address) ? end : address);
 }
 
 void* memory_start;
 void* memory_location;
-size_t memory_block_alignment;
-size_t memory_block_size;
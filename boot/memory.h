@@ -33,30 +33,47 @@ extern "C" {
 #endif
 
 /**
- * @brief Initializes memory for management.
+ * @brief First byte of the kernel image, defined by linker.ld.
  */
-void memory_initialize(void);
+extern char __kernel_start[];
 
 /**
- * @brief Starting location in memory to begin allocation. Must be after
- * the end of kernel code in memory.
+ * @brief First byte past the kernel image, defined by linker.ld. Aligned to
+ * a page.
  */
-extern void* memory_start;
+extern char __kernel_end[];
 
 /**
- * @brief Current location in memory to allocate memory at.
+ * @brief Initializes memory for management. The early boot arena is used
+ * to set up the frame allocator, which then takes over all memory past the
+ * kernel image except what the arena handed out.
  */
-extern void* memory_location;
+void memory_initialize(void);
 
 /**
- * @brief Block alignment for memory management. Must be divisible by 2.
+ * @brief Allocates from the early boot arena. Memory from the arena is never
+ * freed, so this is only meant for structures that live as long as the
+ * kernel and are needed before the frame allocator is up.
+ *
+ * @param size Size in bytes.
+ * @param alignment Alignment in bytes. Must be a power of two.
+ *
+ * @return Allocated memory, or NULL once the arena has been handed off to
+ * the frame allocator.
  */
-extern size_t memory_block_alignment;
+void* memory_allocate(size_t size, size_t alignment);
 
 /**
- * @brief Block size for memory management.
+ * @brief Start of the early boot arena: the end of the kernel image, moved
+ * past any boot module or boot information placed right after it.
  */
-extern size_t memory_block_size;
+extern void* memory_start;
+
+/**
+ * @brief Next free byte of the early boot arena. Once the arena is handed
+ * off, [memory_start, memory_location) is what it handed out.
+ */
+extern void* memory_location;
 
 #ifdef __cplusplus
 } /* extern "C" */
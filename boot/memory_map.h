@@ -28,6 +28,26 @@
 
 #include <boot/multiboot.h>
 
+/**
+ * @brief Multiboot flag set when mem_lower and mem_upper are valid.
+ */
+#define MULTIBOOT_FLAG_MEMORY 0x001
+
+/**
+ * @brief Multiboot flag set when mods_count and mods_addr are valid.
+ */
+#define MULTIBOOT_FLAG_MODULES 0x008
+
+/**
+ * @brief Multiboot flag set when mmap_length and mmap_addr are valid.
+ */
+#define MULTIBOOT_FLAG_MEMORY_MAP 0x040
+
+/**
+ * @brief Memory map entry type for memory available to the OS.
+ */
+#define MULTIBOOT_MEMORY_AVAILABLE 1
+
 /**
  * @brief Gets Multiboot info structure.
  */
@@ -121,3 +121,11 @@ void terminal_write_string(const char* str)
 		terminal_handle_char(str[i]);
 	}
 }
+
+void terminal_write(const char* data, size_t size)
+{
+	for (size_t i = 0; i < size; i++)
+	{
+		terminal_handle_char(data[i]);
+	}
+}
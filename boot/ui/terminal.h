@@ -112,4 +112,13 @@ void terminal_handle_char(const char c);
 
 void terminal_write_string(const char* str);
 
+/**
+ * @brief Writes bytes to the terminal, interpreting newlines. The bytes
+ * need not be null-terminated, and a null byte is written like any other.
+ *
+ * @param data Bytes to write.
+ * @param size Number of bytes to write.
+ */
+void terminal_write(const char* data, size_t size);
+
 #endif /* TERMINAL_H_INCLUDED */
@@ -12,6 +12,30 @@
 extern "C" {
 #endif
 
+/* Character class bits of _ctype_table. */
+#define _CTYPE_UPPER 0x01
+#define _CTYPE_LOWER 0x02
+#define _CTYPE_DIGIT 0x04
+#define _CTYPE_SPACE 0x08
+#define _CTYPE_PUNCT 0x10
+#define _CTYPE_CNTRL 0x20
+#define _CTYPE_XDIGIT 0x40
+/* Set only for ' ', the one white space character that prints. */
+#define _CTYPE_BLANK 0x80
+
+/**
+ * @brief Character class bits of every unsigned char value. Characters
+ * outside ASCII, and EOF, have none.
+ */
+extern const unsigned char _ctype_table[256];
+
+/**
+ * @brief Tests whether character c has any of the given class bits, with
+ * a single load; c is evaluated once.
+ */
+#define _CTYPE_TEST(c, classes) \
+    ((int) (_ctype_table[(unsigned char) (c)] & (classes)))
+
 /**
  * @brief Returns true if isalpha(c) or idigit(c) is true.
  *
@@ -68,8 +92,8 @@ int isgraph(int c);
 int islower(int c);
 
 /**
- * @brief Returns true if character is a printing character, including white
- * space.
+ * @brief Returns true if character is a printing character, including the
+ * space character.
  *
  * @param c Character to check.
  *
@@ -135,6 +159,22 @@ int tolower(int c);
  */
 int toupper(int c);
 
+/* The predicates are also macros, so that each is a single load and mask.
+ * The functions remain for taking their addresses. */
+#define isalnum(c) _CTYPE_TEST(c, _CTYPE_UPPER | _CTYPE_LOWER | _CTYPE_DIGIT)
+#define isalpha(c) _CTYPE_TEST(c, _CTYPE_UPPER | _CTYPE_LOWER)
+#define iscntrl(c) _CTYPE_TEST(c, _CTYPE_CNTRL)
+#define isdigit(c) _CTYPE_TEST(c, _CTYPE_DIGIT)
+#define isgraph(c) _CTYPE_TEST(c, \
+    _CTYPE_UPPER | _CTYPE_LOWER | _CTYPE_DIGIT | _CTYPE_PUNCT)
+#define islower(c) _CTYPE_TEST(c, _CTYPE_LOWER)
+#define isprint(c) _CTYPE_TEST(c, \
+    _CTYPE_UPPER | _CTYPE_LOWER | _CTYPE_DIGIT | _CTYPE_PUNCT | _CTYPE_BLANK)
+#define ispunct(c) _CTYPE_TEST(c, _CTYPE_PUNCT)
+#define isspace(c) _CTYPE_TEST(c, _CTYPE_SPACE)
+#define isupper(c) _CTYPE_TEST(c, _CTYPE_UPPER)
+#define isxdigit(c) _CTYPE_TEST(c, _CTYPE_XDIGIT)
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,32 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Error code for an invalid argument.
+ */
+#define EINVAL 22
+
+/**
+ * @brief Error code for an argument outside the domain of a function.
+ */
+#define EDOM 33
+
+/**
+ * @brief Error code for a result outside the range of its type.
+ */
+#define ERANGE 34
+
+/**
+ * @brief Error code for an invalid multibyte sequence.
+ */
+#define EILSEQ 84
+
+/**
+ * @brief Last error reported by a library function. Functions only set it
+ * on error, so it must be cleared before a call to check it afterwards.
+ */
+extern int errno;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,119 @@
+/**
+ * @file limits.h
+ *
+ * @author Seth Nils
+ * @date 2014/6/5
+ */
+
+#ifndef _LIMITS_H_INCLUDED
+#define _LIMITS_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of bits in a char.
+ */
+#define CHAR_BIT __CHAR_BIT__
+
+/**
+ * @brief Largest value of a signed char.
+ */
+#define SCHAR_MAX __SCHAR_MAX__
+
+/**
+ * @brief Smallest value of a signed char.
+ */
+#define SCHAR_MIN (-SCHAR_MAX - 1)
+
+/**
+ * @brief Largest value of an unsigned char.
+ */
+#define UCHAR_MAX (SCHAR_MAX * 2 + 1)
+
+#ifdef __CHAR_UNSIGNED__
+/**
+ * @brief Smallest value of a char.
+ */
+#define CHAR_MIN 0
+
+/**
+ * @brief Largest value of a char.
+ */
+#define CHAR_MAX UCHAR_MAX
+#else
+#define CHAR_MIN SCHAR_MIN
+#define CHAR_MAX SCHAR_MAX
+#endif
+
+/**
+ * @brief Largest number of bytes in a multibyte character.
+ */
+#define MB_LEN_MAX 1
+
+/**
+ * @brief Largest value of a short.
+ */
+#define SHRT_MAX __SHRT_MAX__
+
+/**
+ * @brief Smallest value of a short.
+ */
+#define SHRT_MIN (-SHRT_MAX - 1)
+
+/**
+ * @brief Largest value of an unsigned short.
+ */
+#define USHRT_MAX (SHRT_MAX * 2 + 1)
+
+/**
+ * @brief Largest value of an int.
+ */
+#define INT_MAX __INT_MAX__
+
+/**
+ * @brief Smallest value of an int.
+ */
+#define INT_MIN (-INT_MAX - 1)
+
+/**
+ * @brief Largest value of an unsigned int.
+ */
+#define UINT_MAX (INT_MAX * 2U + 1U)
+
+/**
+ * @brief Largest value of a long.
+ */
+#define LONG_MAX __LONG_MAX__
+
+/**
+ * @brief Smallest value of a long.
+ */
+#define LONG_MIN (-LONG_MAX - 1L)
+
+/**
+ * @brief Largest value of an unsigned long.
+ */
+#define ULONG_MAX (LONG_MAX * 2UL + 1UL)
+
+/**
+ * @brief Largest value of a long long.
+ */
+#define LLONG_MAX __LONG_LONG_MAX__
+
+/**
+ * @brief Smallest value of a long long.
+ */
+#define LLONG_MIN (-LLONG_MAX - 1LL)
+
+/**
+ * @brief Largest value of an unsigned long long.
+ */
+#define ULLONG_MAX (LLONG_MAX * 2ULL + 1ULL)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _LIMITS_H_INCLUDED */
@@ -12,6 +12,11 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Positive double returned by functions whose result overflows.
+ */
+#define HUGE_VAL (__builtin_huge_val())
+
 #ifdef __cplusplus
 }
 #endif
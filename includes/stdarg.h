@@ -12,6 +12,31 @@
 extern "C" {
 #endif
 
+/**
+ * @brief State for walking a variable argument list.
+ */
+typedef __builtin_va_list va_list;
+
+/**
+ * @brief Starts walking the arguments after the named parameter last.
+ */
+#define va_start(ap, last) __builtin_va_start(ap, last)
+
+/**
+ * @brief Takes the next argument, of the given type.
+ */
+#define va_arg(ap, type) __builtin_va_arg(ap, type)
+
+/**
+ * @brief Copies the walk state of src into dest.
+ */
+#define va_copy(dest, src) __builtin_va_copy(dest, src)
+
+/**
+ * @brief Finishes walking an argument list.
+ */
+#define va_end(ap) __builtin_va_end(ap)
+
 #ifdef __cplusplus
 }
 #endif
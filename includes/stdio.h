@@ -22,13 +22,15 @@
 #ifndef _STDIO_H_INCLUDED
 #define _STDIO_H_INCLUDED
 
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 /**
  * @note "stdio.h" cannot be properly and fully implemented until filesystem
- * abstractions have been implemented.
+ * abstractions have been implemented. Until then the only streams are
+ * stdout and stderr, which write to the terminal.
  */
 
 #ifdef __cplusplus
@@ -36,13 +38,243 @@ extern "C" {
 #endif
 
 /**
- * @brief Directly writes a string to stdout without formatting.
+ * @brief Value returned by character functions at end of file or on error.
+ */
+#define EOF (-1)
+
+/**
+ * @brief Size of the buffer of a buffered stream.
+ */
+#define BUFSIZ 512
+
+/**
+ * @brief Buffering mode that writes only when the buffer fills.
+ */
+#define _IOFBF 0
+
+/**
+ * @brief Buffering mode that also writes at the end of each line.
+ */
+#define _IOLBF 1
+
+/**
+ * @brief Buffering mode that writes every call straight through.
+ */
+#define _IONBF 2
+
+/**
+ * @brief Output stream. Its contents are private to stdio.c.
+ */
+typedef struct FILE FILE;
+
+/**
+ * @brief Lets the compiler check the arguments of a printf-style function
+ * against its format string.
+ *
+ * @param string Position of the format string parameter, counting from 1.
+ * @param first Position of the first formatted argument, or 0 for
+ * functions that take a va_list.
+ */
+#define PRINTF_FORMAT(string, first) \
+    __attribute__((__format__(__printf__, string, first)))
+
+/**
+ * @brief Standard output, line buffered.
+ */
+extern FILE* stdout;
+
+/**
+ * @brief Standard error, unbuffered.
+ */
+extern FILE* stderr;
+
+/**
+ * @brief Writes objects to a stream. Data at least as large as the
+ * stream's buffer is passed to the output in one piece instead of being
+ * copied through the buffer.
+ *
+ * @param ptr Objects to write. They are only read.
+ * @param size Size of each object.
+ * @param nobj Number of objects to write.
+ * @param stream Stream to write to.
+ *
+ * @return Number of objects written.
+ */
+size_t fwrite(const void* ptr, size_t size, size_t nobj, FILE* stream);
+
+/**
+ * @brief Writes a string to a stream, without its null terminator.
+ *
+ * @param s String to write.
+ * @param stream Stream to write to.
+ *
+ * @return Non-negative on success, EOF on error.
+ */
+int fputs(const char* s, FILE* stream);
+
+/**
+ * @brief Writes a string and a newline to stdout.
+ *
+ * @param s String to write.
+ *
+ * @return Non-negative on success, EOF on error.
+ */
+int puts(const char* s);
+
+/**
+ * @brief Writes a character to a stream.
+ *
+ * @param c Character to write, converted to unsigned char.
+ * @param stream Stream to write to.
+ *
+ * @return Character written, or EOF on error.
+ */
+int fputc(int c, FILE* stream);
+
+/**
+ * @brief Writes a character to a stream. Equivalent to fputc.
+ *
+ * @param c Character to write, converted to unsigned char.
+ * @param stream Stream to write to.
+ *
+ * @return Character written, or EOF on error.
+ */
+int putc(int c, FILE* stream);
+
+/**
+ * @brief Writes a character to stdout.
+ *
+ * @param c Character to write, converted to unsigned char.
+ *
+ * @return Character written, or EOF on error.
+ */
+int putchar(int c);
+
+/**
+ * @brief Writes any buffered data of a stream.
+ *
+ * @param stream Stream to flush, or NULL to flush every stream.
+ *
+ * @return Zero on success, EOF on error.
+ */
+int fflush(FILE* stream);
+
+/**
+ * @brief Sets the buffering of a stream, after flushing it.
+ *
+ * @param stream Stream to change.
+ * @param buf Buffer to use, or NULL to keep the stream's own buffer.
+ * @param mode _IOFBF, _IOLBF or _IONBF.
+ * @param size Size of buf in bytes.
+ *
+ * @return Zero on success, non-zero if the mode is invalid or a buffered
+ * mode was asked for without a buffer.
+ */
+int setvbuf(FILE* stream, char* buf, int mode, size_t size);
+
+/**
+ * @brief Writes formatted output to stdout. See vsnprintf for the
+ * conversions supported.
+ *
+ * @param format Format string.
+ *
+ * @return Number of characters written, or a negative value if the count
+ * does not fit in an int.
+ */
+int printf(const char* format, ...) PRINTF_FORMAT(1, 2);
+
+/**
+ * @brief Writes formatted output to a stream. The stream stays locked for
+ * the whole call, so output from other CPUs is never interleaved with it.
+ *
+ * @param stream Stream to write to.
+ * @param format Format string.
+ *
+ * @return Number of characters written, or a negative value if the count
+ * does not fit in an int.
+ */
+int fprintf(FILE* stream, const char* format, ...) PRINTF_FORMAT(2, 3);
+
+/**
+ * @brief Writes formatted output to stdout, taking the arguments as a
+ * va_list.
  *
- * @param str String to write. This should be null-terminated.
+ * @param format Format string.
+ * @param args Arguments to format.
+ *
+ * @return Number of characters written, or a negative value if the count
+ * does not fit in an int.
+ */
+int vprintf(const char* format, va_list args) PRINTF_FORMAT(1, 0);
+
+/**
+ * @brief Writes formatted output to a stream, taking the arguments as a
+ * va_list.
+ *
+ * @param stream Stream to write to.
+ * @param format Format string.
+ * @param args Arguments to format.
+ *
+ * @return Number of characters written, or a negative value if the count
+ * does not fit in an int.
+ */
+int vfprintf(FILE* stream, const char* format, va_list args)
+    PRINTF_FORMAT(2, 0);
+
+/**
+ * @brief Writes formatted output to a buffer, truncating it to fit.
+ *
+ * @param s Buffer to write to. May be NULL if n is zero.
+ * @param n Size of s in bytes, including the null terminator.
+ * @param format Format string.
+ *
+ * @return Length the whole output would have had, not counting the null
+ * terminator, or a negative value if it does not fit in an int.
+ */
+int snprintf(char* s, size_t n, const char* format, ...) PRINTF_FORMAT(3, 4);
+
+/**
+ * @brief Writes formatted output to a buffer, taking the arguments as a
+ * va_list. The output is produced in one pass, straight into s, without
+ * allocating memory. Output past n - 1 characters is counted but dropped,
+ * and s is null-terminated whenever n is not zero.
+ *
+ * Conversions are %d, %i, %u, %o, %x, %X, %c, %s, %p and %%, with the
+ * flags '-', '+', ' ', '#' and '0', a width and a precision (either of which
+ * may be '*'), and the length modifiers hh, h, l, ll, j, z and t. There is
+ * no floating point conversion.
+ *
+ * @param s Buffer to write to. May be NULL if n is zero.
+ * @param n Size of s in bytes, including the null terminator.
+ * @param format Format string.
+ * @param args Arguments to format.
+ *
+ * @return Length the whole output would have had, not counting the null
+ * terminator, or a negative value if it does not fit in an int.
+ */
+int vsnprintf(char* s, size_t n, const char* format, va_list args)
+    PRINTF_FORMAT(3, 0);
+
+/**
+ * @brief Directly writes a string to stdout without formatting, flushing it
+ * immediately.
+ *
+ * @param str String to write. It need not be null-terminated, and is never
+ * modified.
  * @param len Length of the string to write.
  */
 void write(const char* str, size_t len);
 
+/**
+ * @brief Writes a string straight to the terminal without ever waiting for
+ * the stdout lock, for use when the kernel may have stopped while holding
+ * it. Whatever stdout has buffered is flushed first if the lock is free.
+ *
+ * @param str String to write. It need not be null-terminated.
+ * @param len Length of the string to write.
+ */
+void write_emergency(const char* str, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
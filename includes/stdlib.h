@@ -32,6 +32,11 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Largest value returned by rand.
+ */
+#define RAND_MAX 0x7FFFFFFF
+
 /**
  * @brief Converts string to double.
  *
@@ -62,7 +67,8 @@ long atol(const char* s);
 /**
  * @brief Converts the prefix of a string to double, ignoring leading white
  * space; it stores a pointer to any unconverted suffix in a pointer unless
- * the pointer provided is NULL.
+ * the pointer provided is NULL. Decimal numbers, "inf", "infinity" and "nan"
+ * are accepted, and the result is the nearest double, ties to even.
  *
  * @param s String containing prefix to convert.
  * @param endp Pointer in which to store any unconverted suffix from s.
@@ -116,7 +122,9 @@ unsigned long strtoul(const char* s, char** endp, int base);
 
 /**
  * @brief Returns a pseudo-random integer in the range 0 to RAND_MAX, which
- * is at least 32767.
+ * is at least 32767. The sequence comes from xoshiro128**, and is the same
+ * for the same seed on every run; the kernel's random_get is the one to use
+ * for values that should differ between boots.
  *
  * @return Pseudo-random integer generated.
  */
@@ -363,6 +371,51 @@ char* sitoa(size_t val, char* str, int base);
  */
 char* btoa(uint8_t val, char* str, size_t bits);
 
+/**
+ * @brief Sorts 32-bit unsigned integers into ascending order. Behaves like
+ * qsort with a comparator of the integers, which it calls inline.
+ *
+ * @param base Pointer to first element of array.
+ * @param n Number of elements in array.
+ */
+void qsort_uint32(uint32_t* base, size_t n);
+
+/**
+ * @brief Searches sorted 32-bit unsigned integers for a key, like bsearch
+ * with the comparison inlined. The range is halved without branching on
+ * the data.
+ *
+ * @param key Key to search for.
+ * @param base Pointer to first element of array. Items in the array must be
+ * in ascending order.
+ * @param n Number of elements in array.
+ *
+ * @return Pointer to a matching item, or NULL if none exists.
+ */
+static inline const uint32_t* bsearch_uint32(
+    uint32_t key,
+    const uint32_t* base,
+    size_t n)
+{
+    if (n == 0)
+    {
+        return (NULL);
+    }
+
+    while (n > 1)
+    {
+        size_t half = n / 2;
+        size_t next = (n - half) / 2;
+
+        __builtin_prefetch(base + next);
+        __builtin_prefetch(base + half + next);
+        base = (base[half] <= key) ? base + half : base;
+        n -= half;
+    }
+
+    return ((*base == key) ? base : NULL);
+}
+
 /* The following are all parts of the standard library that have not been
  * implemented because the do not apply in a freestanding environment. */
 #if 0
@@ -36,6 +36,20 @@
  */
 char* strcpy(char* s, const char* ct);
 
+/**
+ * @brief Copies string ct to string s, including terminating character '\0',
+ * and returns the end of the copy. Appending with the result, instead of
+ * with strcat, avoids measuring s again for every piece.
+ *
+ * @param s Destination string.
+ * @param ct Source string.
+ *
+ * @return Pointer to the terminating '\0' written to s.
+ *
+ * @warning The two strings may not overlap.
+ */
+char* stpcpy(char* s, const char* ct);
+
 /**
  * @brief Copies, at most, n characters of string ct to string s.
  *
@@ -51,6 +65,20 @@ char* strcpy(char* s, const char* ct);
  */
 char* strncpy(char* s, const char* ct, size_t n);
 
+/**
+ * @brief Copies as much of string ct to s as fits in n bytes, always
+ * terminating s if n is not zero.
+ *
+ * @param s Destination buffer.
+ * @param ct Source string.
+ * @param n Size of s in bytes.
+ *
+ * @return Length of ct. The copy was cut short if this is n or more.
+ *
+ * @warning The two strings may not overlap.
+ */
+size_t strlcpy(char* s, const char* ct, size_t n);
+
 /**
  * @brief Concatenates string ct to end of string s.
  *
@@ -78,6 +106,22 @@ char* strcat(char* s, const char* ct);
  */
 char* strncat(char* s, const char* ct, size_t n);
 
+/**
+ * @brief Appends as much of string ct to string s as fits in n bytes,
+ * always terminating s if it was terminated within n bytes.
+ *
+ * @param s Destination string.
+ * @param ct Source string.
+ * @param n Size of the buffer holding s, in bytes.
+ *
+ * @return Length of the string it tried to create: the length of s, or n
+ * if s is not terminated within n bytes, plus the length of ct. The result
+ * was cut short if this is n or more.
+ *
+ * @warning The two strings may not overlap.
+ */
+size_t strlcat(char* s, const char* ct, size_t n);
+
 /**
  * @brief Compares string cs to string ct.
  *
@@ -114,7 +158,8 @@ int strncmp(const char* cs, const char* ct, size_t n);
  * @param c Character to search for.
  *
  * @return Pointer to first occurrence of character c in string cs. If c
- * is not present in cs, return NULL.
+ * is not present in cs, return NULL. The terminator is part of the string,
+ * so searching for '\0' finds it.
  *
  * @note c is an unsigned character promoted to int, internally treated
  * as char.
@@ -217,7 +262,8 @@ char* strerror(int n);
  *
  * @note If argument s is a NULL pointer, the pointer returned points to the
  * next token from the string used in the last non-NULL call. The string ct
- * may be different on each call. Returns NULL if no further token was found.
+ * may be different on each call. Delimiters before a token are skipped, so
+ * tokens are never empty. Returns NULL if no further token was found.
  */
 char* strtok(char* s, const char* ct);
 
@@ -287,6 +333,20 @@ void* memset(void* s, int c, size_t n);
  * purpose of this header.
  */
 
+/**
+ * @brief Finds first occurrence of object ct in object cs, if any. Runs in
+ * time linear in n + m.
+ *
+ * @param cs Pointer to beginning of memory to search in.
+ * @param n Number of memory locations to search in.
+ * @param ct Pointer to beginning of memory to search for.
+ * @param m Number of memory locations to search for.
+ *
+ * @return Pointer to first occurrence of ct in cs, or NULL if not present.
+ * Returns cs if m is 0.
+ */
+void* memmem(const void* cs, size_t n, const void* ct, size_t m);
+
 /**
  * @brief Reverses a string.
  *